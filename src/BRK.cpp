@@ -30,11 +30,10 @@ struct BRK : Module {
 		NUM_LIGHTS
 	};
 
-	// Messages to left module (RKD) - this is the default.
-	bool leftMessages[2][NUM_PARAMS] = {};
-
-	// Messages to right module (RKD) - valid only if BRK is left, and no other BRK at right side (otherwise ignored).
-	bool rightMessages[2][NUM_PARAMS] = {};
+	// Last sent switches (one bit per switch, -1 to force sending), generation of last sent message, and RKD receiver.
+	int sentSwitches = -1;
+	uint32_t generation = 0;
+	int64_t rkdModuleId = -1;
 
 	BRK() {
 		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
@@ -44,37 +43,53 @@ struct BRK : Module {
 		configParam(SWITCH_MAXDIVRANGE16, 0.0, 1.0, 1.0, "Max Div 16"); // On by default;
 		configParam(SWITCH_SPREAD, 0.0, 1.0, 0.0, "Spread"); // Off by default;
 		configParam(SWITCH_AUTORESET, 0.0, 1.0, 0.0, "Auto-Reset"); // Off by default;
-		leftExpander.producerMessage = leftMessages[0];
-		leftExpander.consumerMessage = leftMessages[1];
-		rightExpander.producerMessage = rightMessages[0];
-		rightExpander.consumerMessage = rightMessages[1];
+		// BRK doesn't receive messages: switches are written into message buffers of RKD module.
 	}
 
 	void process(const ProcessArgs &args) override {
 		// DSP processing...
-		if (leftExpander.module && leftExpander.module->model == modelRKD) {
-			// BRK expander is connected to RKD (right-side - take priority): sending switches positions to relevant jumpers to adjacent (left) RKD module.
-			bool *message = (bool*)leftExpander.module->rightExpander.producerMessage;
-			message[SWITCH_COUNTINGDOWN] = (params[SWITCH_COUNTINGDOWN].getValue() == 1.0);
-			message[SWITCH_GATE] = (params[SWITCH_GATE].getValue() == 1.0);
-			message[SWITCH_MAXDIVRANGE16] = (params[SWITCH_MAXDIVRANGE32].getValue() == 1.0);
-			message[SWITCH_MAXDIVRANGE32] = (params[SWITCH_MAXDIVRANGE16].getValue() == 1.0);
-			message[SWITCH_SPREAD] = (params[SWITCH_SPREAD].getValue() == 1.0);
-			message[SWITCH_AUTORESET] = (params[SWITCH_AUTORESET].getValue() == 1.0);
-			// Flip messages.
-			leftExpander.module->rightExpander.messageFlipRequested = true;
+		Module *rkdModule = nullptr;
+		if (leftExpander.module && leftExpander.module->model == modelRKD)
+			rkdModule = leftExpander.module; // BRK expander is connected to RKD (right-side - take priority).
+			else if (rightExpander.module && rightExpander.module->model == modelRKD)
+				rkdModule = rightExpander.module; // BRK expander is connected to RKD (left-side).
+		if (!rkdModule) {
+			// No RKD: next connected RKD will receive switches.
+			rkdModuleId = -1;
+			return;
 		}
-		else if (rightExpander.module && rightExpander.module->model == modelRKD) {
-			// BRK expander is connected to RKD (left-side): sending switches positions to relevant jumpers to adjacent (right) RKD module.
-			bool *message = (bool*)rightExpander.module->leftExpander.producerMessage;
-			message[SWITCH_COUNTINGDOWN] = (params[SWITCH_COUNTINGDOWN].getValue() == 1.0);
-			message[SWITCH_GATE] = (params[SWITCH_GATE].getValue() == 1.0);
-			message[SWITCH_MAXDIVRANGE16] = (params[SWITCH_MAXDIVRANGE32].getValue() == 1.0);
-			message[SWITCH_MAXDIVRANGE32] = (params[SWITCH_MAXDIVRANGE16].getValue() == 1.0);
-			message[SWITCH_SPREAD] = (params[SWITCH_SPREAD].getValue() == 1.0);
-			message[SWITCH_AUTORESET] = (params[SWITCH_AUTORESET].getValue() == 1.0);
+		// Switches positions to relevant jumpers (note Max-Div-Range switches are swapped on panel).
+		int switches = 0;
+		if (params[SWITCH_COUNTINGDOWN].getValue() == 1.0)
+			switches |= 1 << SWITCH_COUNTINGDOWN;
+		if (params[SWITCH_GATE].getValue() == 1.0)
+			switches |= 1 << SWITCH_GATE;
+		if (params[SWITCH_MAXDIVRANGE32].getValue() == 1.0)
+			switches |= 1 << SWITCH_MAXDIVRANGE16;
+		if (params[SWITCH_MAXDIVRANGE16].getValue() == 1.0)
+			switches |= 1 << SWITCH_MAXDIVRANGE32;
+		if (params[SWITCH_SPREAD].getValue() == 1.0)
+			switches |= 1 << SWITCH_SPREAD;
+		if (params[SWITCH_AUTORESET].getValue() == 1.0)
+			switches |= 1 << SWITCH_AUTORESET;
+		// Sending message only when a switch was changed, or RKD module was changed.
+		if ((switches != sentSwitches) || (rkdModule->id != rkdModuleId)) {
+			sentSwitches = switches;
+			rkdModuleId = rkdModule->id;
+			generation++;
+			bool bRKDatLeft = (rkdModule == leftExpander.module);
+			BRKMessage *message = &((RKDExpanderMessage*)(bRKDatLeft ? rkdModule->rightExpander.producerMessage : rkdModule->leftExpander.producerMessage))->brk;
+			message->version = BRK_MESSAGE_VERSION;
+			message->senderId = id;
+			message->generation = generation;
+			for (int i = SWITCH_COUNTINGDOWN; i < NUM_PARAMS; i++)
+				message->switches[i] = (switches & (1 << i)) != 0;
+			message->tableSet = -1;
+			message->rotateOffset = 0;
 			// Flip messages.
-			rightExpander.module->leftExpander.messageFlipRequested = true;
+			if (bRKDatLeft)
+				rkdModule->rightExpander.messageFlipRequested = true;
+				else rkdModule->leftExpander.messageFlipRequested = true;
 		}
 
 	} // end of "process"...
@@ -5,11 +5,727 @@
 //// - Frequency Counter.                                          /////
 //// - BPM Meter.                                                  /////
 //// - Peak Counter (aka pulse counter).                           /////
+//// - Poly Meter (all channels of a polyphonic cable).            /////
 ////////////////////////////////////////////////////////////////////////
 
 #include "Ohmer.hpp"
 #include <dsp/digital.hpp>
 #include <string>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <condition_variable>
+#include <memory>
+
+// Notes tables used by CV Tuner mode, for each notation (0: C-D-E...B, 1: Do-Re-Mi) and sharps/flats (0: sharps, 1: flats),
+// including octave (C-1 to B9). Shared by all Metriks modules: built only once, on first use.
+struct MetriksNotesTables {
+	char notes[2][2][132][8];
+
+	MetriksNotesTables() {
+		static const char *baseNoteNames[2][2][12] = {
+			{{"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"},
+			{"C", "Db", "D", "Eb", "E", "F", "Gb", "G", "Ab", "A", "Bb", "B"}},
+			{{"Do", "Do#", "Re", "Re#", "Mi", "Fa", "Fa#", "Sol", "Sol#", "La", "La#", "Si"},
+			{"Do", "Reb", "Re", "Mib", "Mi", "Fa", "Solb", "Sol", "Lab", "La", "Sib", "Si"}}
+		};
+		for (int n = 0; n < 2; n++)
+			for (int f = 0; f < 2; f++)
+				for (int i = 0; i < 132; i++)
+					snprintf(notes[n][f][i], sizeof(notes[n][f][i]), "%s%i", baseNoteNames[n][f][i % 12], (i / 12) - 1);
+	}
+};
+
+static const MetriksNotesTables &metriksNotesTables() {
+	static const MetriksNotesTables tables;
+	return tables;
+}
+
+// Maximum number of parameters per option.
+#define METRIKS_MAX_PARAMS 17
+
+// Voltmeter: metering options, and first level metering option (RMS, mean, crest factor and true-peak are last ones).
+#define METRIKS_VLTM_METERINGS 10
+#define METRIKS_VLTM_LEVEL 6
+
+// Voltmeter: titles (first line of DMD), for each metering option.
+static const char *metriksVoltmeterTitles[METRIKS_VLTM_METERINGS] = {"Voltmeter", "Voltm. Min.", "Voltm. Max.", "Voltm. Medn.", "Voltm. P5", "Voltm. P95", "Voltm. RMS", "Voltm. Mean", "Crest Factor", "True Peak"};
+
+// Voltmeter: formatting given voltage (rounded at given decimals, always signed, followed by "V") for second line of DMD, and its
+// horizontal offset (right-aligned). Voltages having more than five digits are out of range.
+static void metriksFormatVoltage(float voltage, int decimals, char *text, size_t size, float &offset) {
+	static const float vCeiling[4] = {99999.0f, 9999.99f, 999.999f, 99.9999f};
+	decimals = clamp(decimals, 0, 3);
+	double scale = std::pow(10.0, decimals);
+	double rounded = std::round((double)(voltage) * scale) / scale;
+	if (std::fabs(rounded) > vCeiling[decimals]) {
+		// Voltage is out of range (overflow).
+		offset = 2.583f;
+		snprintf(text, size, "!Out.Rang.!");
+		return;
+	}
+	snprintf(text, size, "%c%.*fV", (rounded < 0.0) ? '-' : '+', decimals, std::fabs(rounded));
+	if (decimals == 0)
+		offset = 96.0f - (strlen(text) * 12.0f);
+		else offset = 102.0f - (strlen(text) * 12.0f);
+}
+
+// Voltmeter: formatting given ratio (crest factor, unsigned, without unit) for second line of DMD, and its horizontal offset (right-
+// aligned). "--" while ratio isn't measurable (silence).
+static void metriksFormatRatio(float ratio, int decimals, char *text, size_t size, float &offset) {
+	if (ratio > 0.0f)
+		snprintf(text, size, "%.*f", clamp(decimals, 0, 3), std::min(ratio, 99999.0f));
+		else snprintf(text, size, "--");
+	offset = 102.0f - (strlen(text) * 12.0f);
+}
+
+// Voltmeter: streaming quantile (median, percentiles) using P-square algorithm (Jain & Chlamtac): only five markers are kept (heights
+// and positions), adjusted on each sample by parabolic (or linear) prediction. Constant memory, O(1) per sample, no buffer. Positions
+// and counter are 64-bit (or double), since they're growing with each sample: at audio rate, a float would lose increments after
+// about 2^24 samples (six minutes), and an int would overflow after about 12 hours.
+struct MetriksP2Quantile {
+	// Quantile to estimate (0.5 for median).
+	double quantile = 0.5;
+	// Number of samples (first five are used to initialize markers).
+	int64_t count = 0;
+	// Markers: heights, actual positions, desired positions, and increments of desired positions.
+	double heights[5] = {};
+	double positions[5] = {};
+	double desired[5] = {};
+	double increments[5] = {};
+
+	MetriksP2Quantile(float givenQuantile) {
+		quantile = givenQuantile;
+		reset();
+	}
+
+	void reset() {
+		count = 0;
+		for (int i = 0; i < 5; i++)
+			positions[i] = i;
+		desired[0] = 0.0;
+		desired[1] = 2.0 * quantile;
+		desired[2] = 4.0 * quantile;
+		desired[3] = 2.0 + 2.0 * quantile;
+		desired[4] = 4.0;
+		increments[0] = 0.0;
+		increments[1] = quantile / 2.0;
+		increments[2] = quantile;
+		increments[3] = (1.0 + quantile) / 2.0;
+		increments[4] = 1.0;
+	}
+
+	void process(float x) {
+		if (count < 5) {
+			// Initialization: first five samples are kept sorted (insertion).
+			int i = (int)(count++);
+			while ((i > 0) && (heights[i - 1] > x)) {
+				heights[i] = heights[i - 1];
+				i--;
+			}
+			heights[i] = x;
+			return;
+		}
+		// Cell of new sample (extreme markers are updated if required).
+		int k;
+		if (x < heights[0]) {
+			heights[0] = x;
+			k = 0;
+		}
+		else if (x >= heights[4]) {
+			heights[4] = x;
+			k = 3;
+		}
+		else {
+			k = 0;
+			while (x >= heights[k + 1])
+				k++;
+		}
+		for (int i = k + 1; i < 5; i++)
+			positions[i]++;
+		for (int i = 0; i < 5; i++)
+			desired[i] += increments[i];
+		count++;
+		// Adjusting heights of middle markers, if they're off their desired positions.
+		for (int i = 1; i < 4; i++) {
+			double d = desired[i] - positions[i];
+			if (((d >= 1.0) && (positions[i + 1] - positions[i] > 1.0)) || ((d <= -1.0) && (positions[i - 1] - positions[i] < -1.0))) {
+				int sign = (d >= 1.0) ? 1 : -1;
+				double np = positions[i + 1] - positions[i - 1];
+				double parabolic = heights[i] + sign / np * ((positions[i] - positions[i - 1] + sign) * (heights[i + 1] - heights[i]) / (positions[i + 1] - positions[i]) + (positions[i + 1] - positions[i] - sign) * (heights[i] - heights[i - 1]) / (positions[i] - positions[i - 1]));
+				if ((heights[i - 1] < parabolic) && (parabolic < heights[i + 1]))
+					heights[i] = parabolic;
+					else heights[i] += sign * (heights[i + sign] - heights[i]) / (positions[i + sign] - positions[i]); // Linear prediction.
+				positions[i] += sign;
+			}
+		}
+	}
+
+	// Current estimate (while less than five samples, nearest-rank from sorted samples).
+	float value() {
+		if (count >= 5)
+			return (float)(heights[2]);
+		if (count == 0)
+			return 0.0f;
+		return (float)(heights[clamp((int)(quantile * count), 0, (int)(count) - 1)]);
+	}
+};
+
+// Voltmeter: level metering (RMS, mean, crest factor or true-peak) over a sliding window. Samples are kept into a ring buffer, sum and
+// sum of squares are updated incrementally (O(1) per sample), and window peak is tracked by a monotonic queue (amortized O(1)). True-
+// peak uses 4x oversampling (polyphase windowed-sinc interpolator). Only the selected metering is computed. Ring buffer and queue are
+// sized to selected window, allocated by UI thread (module widget) only once level metering is selected, never while processing.
+#define METRIKS_TRUEPEAK_TAPS 12
+struct MetriksLevelBuffers {
+	// Window length (in samples) these buffers are sized for (0: not allocated).
+	int capacity = 0;
+	std::vector<float> ring;
+	std::vector<float> peakValues;
+	std::vector<uint32_t> peakTimes;
+
+	void allocate(int givenCapacity) {
+		capacity = givenCapacity;
+		ring.assign(capacity, 0.0f);
+		peakValues.assign(capacity + 1, 0.0f);
+		peakTimes.assign(capacity + 1, 0);
+	}
+
+	void release() {
+		capacity = 0;
+		std::vector<float>().swap(ring);
+		std::vector<float>().swap(peakValues);
+		std::vector<uint32_t>().swap(peakTimes);
+	}
+};
+
+struct MetriksLevelMeter {
+	enum Meterings {
+		LEVEL_RMS,
+		LEVEL_MEAN,
+		LEVEL_CREST,
+		LEVEL_TRUEPEAK
+	};
+	int metering = LEVEL_RMS;
+	// Buffers in use (nothing is computed until buffers are given), and selected window length (in samples).
+	MetriksLevelBuffers *buffers = nullptr;
+	int windowLength = 1;
+	// Ring buffer (samples), window length (in samples, limited to buffers capacity), write index, number of samples in window, and
+	// running sums.
+	float *ring = nullptr;
+	int length = 1;
+	int index = 0;
+	int filled = 0;
+	double sum = 0.0;
+	double sumSquares = 0.0;
+	// Window peak: monotonic queue (decreasing peaks, and their sample time), as ring buffer.
+	float *peakValues = nullptr;
+	uint32_t *peakTimes = nullptr;
+	int peakCapacity = 1;
+	int peakHead = 0;
+	int peakCount = 0;
+	uint32_t time = 0;
+	// True-peak: last input samples, and interpolator coefficients (for each of the four phases).
+	float history[METRIKS_TRUEPEAK_TAPS] = {};
+	float coefs[4][METRIKS_TRUEPEAK_TAPS];
+
+	MetriksLevelMeter() {
+		// Windowed-sinc (Hann), delay of (taps / 2 - 1) samples, normalized for unity gain at DC (phase 0 is a pure delay).
+		for (int p = 0; p < 4; p++) {
+			float sumCoefs = 0.0f;
+			for (int k = 0; k < METRIKS_TRUEPEAK_TAPS; k++) {
+				float u = k - (METRIKS_TRUEPEAK_TAPS / 2 - 1) - p / 4.0f;
+				float window = 0.5f * (1.0f + std::cos(M_PI * u / (METRIKS_TRUEPEAK_TAPS / 2)));
+				coefs[p][k] = (u == 0.0f) ? 1.0f : window * std::sin(M_PI * u) / (M_PI * u);
+				sumCoefs += coefs[p][k];
+			}
+			for (int k = 0; k < METRIKS_TRUEPEAK_TAPS; k++)
+				coefs[p][k] /= sumCoefs;
+		}
+	}
+
+	// Using given buffers (allocated by UI thread), until other buffers are given.
+	void setBuffers(MetriksLevelBuffers *givenBuffers) {
+		buffers = givenBuffers;
+		ring = buffers->ring.data();
+		peakValues = buffers->peakValues.data();
+		peakTimes = buffers->peakTimes.data();
+		peakCapacity = buffers->capacity + 1;
+		length = clamp(windowLength, 1, buffers->capacity);
+		restart();
+	}
+
+	// Window change: until buffers sized to new window are given, window is limited to current buffers.
+	void setWindow(float windowTime, float sampleRate) {
+		windowLength = std::max(1, (int)(windowTime * sampleRate));
+		if (buffers != nullptr)
+			length = clamp(windowLength, 1, buffers->capacity);
+		restart();
+	}
+
+	void setMetering(int givenMetering) {
+		if (givenMetering != metering) {
+			metering = givenMetering;
+			restart();
+		}
+	}
+
+	void restart() {
+		index = 0;
+		filled = 0;
+		sum = 0.0;
+		sumSquares = 0.0;
+		peakHead = 0;
+		peakCount = 0;
+		time = 0;
+		for (int k = 0; k < METRIKS_TRUEPEAK_TAPS; k++)
+			history[k] = 0.0f;
+	}
+
+	void process(float x) {
+		if (buffers == nullptr)
+			return;
+		if (metering != LEVEL_TRUEPEAK) {
+			// Running sums: oldest sample is removed once window is full.
+			if (filled == length) {
+				sum -= ring[index];
+				sumSquares -= (double)(ring[index]) * ring[index];
+			}
+			else filled++;
+			ring[index] = x;
+			sum += x;
+			sumSquares += (double)(x) * x;
+			if (++index >= length)
+				index = 0;
+		}
+		if (metering == LEVEL_CREST)
+			pushPeak(std::fabs(x));
+			else if (metering == LEVEL_TRUEPEAK) {
+				// 4x oversampling: peak of all interpolated samples between previous and current input samples.
+				for (int k = METRIKS_TRUEPEAK_TAPS - 1; k > 0; k--)
+					history[k] = history[k - 1];
+				history[0] = x;
+				float peak = 0.0f;
+				for (int p = 0; p < 4; p++) {
+					float y = 0.0f;
+					for (int k = 0; k < METRIKS_TRUEPEAK_TAPS; k++)
+						y += coefs[p][k] * history[k];
+					peak = std::max(peak, std::fabs(y));
+				}
+				pushPeak(peak);
+			}
+		time++;
+	}
+
+	// Monotonic queue: smaller (or equal) peaks at back are dropped, then expired peak (out of window) at front is dropped.
+	void pushPeak(float peak) {
+		while ((peakCount > 0) && (peakValues[(peakHead + peakCount - 1) % peakCapacity] <= peak))
+			peakCount--;
+		peakValues[(peakHead + peakCount) % peakCapacity] = peak;
+		peakTimes[(peakHead + peakCount) % peakCapacity] = time;
+		peakCount++;
+		while ((int)(time - peakTimes[peakHead]) >= length) {
+			peakHead = (peakHead + 1) % peakCapacity;
+			peakCount--;
+		}
+	}
+
+	float rms() {
+		return (filled > 0) ? std::sqrt(std::max(0.0, sumSquares) / filled) : 0.0f;
+	}
+
+	// Current reading (crest factor is a ratio, 0 while not measurable).
+	float value() {
+		switch (metering) {
+			case LEVEL_MEAN:
+				return (filled > 0) ? (float)(sum / filled) : 0.0f;
+			case LEVEL_CREST:
+				return ((peakCount > 0) && (rms() > 0.0f)) ? peakValues[peakHead] / rms() : 0.0f;
+			case LEVEL_TRUEPEAK:
+				return (peakCount > 0) ? peakValues[peakHead] : 0.0f;
+			default:
+				return rms();
+		}
+	}
+};
+
+// Poly Meter: minimum and maximum (since reset), and RMS (over consecutive 0.3 second blocks, latched at end of each block) for all
+// channels of a polyphonic cable, computed four channels at once (SIMD). Statistics are restarted when number of channels changes.
+struct MetriksPolyStats {
+	simd::float_4 mins[4];
+	simd::float_4 maxs[4];
+	simd::float_4 sumSquares[4];
+	simd::float_4 rms[4];
+	int channels = 0;
+	int blockSamples = 13230;
+	int blockCount = 0;
+
+	MetriksPolyStats() {
+		restart();
+	}
+
+	void setBlock(float sampleRate) {
+		blockSamples = std::max(1, (int)(0.3f * sampleRate));
+		restart();
+	}
+
+	void restart() {
+		for (int g = 0; g < 4; g++) {
+			mins[g] = simd::float_4(INFINITY);
+			maxs[g] = simd::float_4(-INFINITY);
+			sumSquares[g] = simd::float_4::zero();
+			rms[g] = simd::float_4::zero();
+		}
+		blockCount = 0;
+	}
+
+	void process(engine::Input &input) {
+		int n = input.getChannels();
+		if (n != channels) {
+			channels = n;
+			restart();
+		}
+		for (int c = 0; c < channels; c += 4) {
+			simd::float_4 v = input.getVoltageSimd<simd::float_4>(c);
+			mins[c / 4] = simd::fmin(mins[c / 4], v);
+			maxs[c / 4] = simd::fmax(maxs[c / 4], v);
+			sumSquares[c / 4] += v * v;
+		}
+		if (++blockCount >= blockSamples) {
+			for (int g = 0; g < 4; g++) {
+				rms[g] = simd::sqrt(sumSquares[g] / simd::float_4((float)(blockCount)));
+				sumSquares[g] = simd::float_4::zero();
+			}
+			blockCount = 0;
+		}
+	}
+
+	// Statistic (0: minimum, 1: maximum, 2: RMS) for given channel.
+	float value(int statistic, int channel) {
+		switch (statistic) {
+			case 0:
+				return mins[channel / 4][channel % 4];
+			case 1:
+				return maxs[channel / 4][channel % 4];
+			default:
+				return rms[channel / 4][channel % 4];
+		}
+	}
+};
+
+// CV Tuner (audio input): pitch detection using YIN algorithm (de Cheveigne & Kawahara), run by a background worker (never by audio
+// thread). Input samples are decimated (box filter) to about 20 kHz, then the difference function is computed from autocorrelation
+// (FFT-accelerated, using dsp::RealFFT) and running energies. Cumulative mean normalized difference, absolute threshold, then
+// parabolic interpolation give the period. Lowest detected frequency is about 20 Hz (window length).
+// Ring buffer holds (at least) twice the analysed span (two windows) at decimation factor used by current sample rate (upto 32, about
+// 24 kHz after decimation at 768 kHz sample rate): audio thread can keep writing during analysis, without overwriting analysed samples.
+#define METRIKS_PITCH_WINDOW 1024
+#define METRIKS_PITCH_FFT 4096
+#define METRIKS_PITCH_MAX_DECIMATION 32
+
+// Decimation factor (box filter) for given sample rate.
+static inline int metriksPitchDecimation(float sampleRate) {
+	return clamp((int)(sampleRate / 20000.0f), 1, METRIKS_PITCH_MAX_DECIMATION);
+}
+
+// Ring buffer length (power of two, samples) for given sample rate: twice the analysed span.
+static inline uint32_t metriksPitchRingLength(float sampleRate) {
+	uint32_t length = 1;
+	while (length < (uint32_t)(4 * METRIKS_PITCH_WINDOW * metriksPitchDecimation(sampleRate)))
+		length <<= 1;
+	return length;
+}
+
+// Ring buffer of input samples (relaxed atomic samples, silent at start). Allocated by UI thread, never by audio thread.
+struct MetriksPitchRing {
+	uint32_t length;
+	std::unique_ptr<std::atomic<float>[]> samples;
+
+	MetriksPitchRing(uint32_t givenLength) {
+		length = givenLength;
+		samples.reset(new std::atomic<float>[length]);
+		for (uint32_t i = 0; i < length; i++)
+			samples[i].store(0.0f, std::memory_order_relaxed);
+	}
+};
+
+struct MetriksPitchDetector {
+	dsp::RealFFT fft {METRIKS_PITCH_FFT};
+	// Decimated frames (two windows), FFT buffers (aligned), and normalized difference function.
+	float frames[2 * METRIKS_PITCH_WINDOW];
+	alignas(16) float window[METRIKS_PITCH_FFT];
+	alignas(16) float frame[METRIKS_PITCH_FFT];
+	alignas(16) float spectrumWindow[METRIKS_PITCH_FFT];
+	alignas(16) float spectrumFrame[METRIKS_PITCH_FFT];
+	alignas(16) float correlation[METRIKS_PITCH_FFT];
+	float differences[METRIKS_PITCH_WINDOW];
+	float normalized[METRIKS_PITCH_WINDOW];
+
+	// Analysing last samples of ring buffer (before given write index), returns detected frequency (Hz), or 0 if no pitch. Returns -1
+	// if audio thread (current write index) has lapped analysed samples during copy: frame is discarded.
+	// Decimation is limited by ring length (ring may be sized for previous sample rate, until it's reallocated).
+	float analyse(const MetriksPitchRing &ring, const std::atomic<uint32_t> &ringWriteIndex, uint32_t writeIndex, float sampleRate) {
+		int decimation = std::min(metriksPitchDecimation(sampleRate), (int)(ring.length / (4 * METRIKS_PITCH_WINDOW)));
+		float rate = sampleRate / decimation;
+		uint32_t start = writeIndex - (uint32_t)(2 * METRIKS_PITCH_WINDOW * decimation);
+		// Decimation, and DC offset removal.
+		double mean = 0.0;
+		for (int i = 0; i < 2 * METRIKS_PITCH_WINDOW; i++) {
+			float sum = 0.0f;
+			for (int k = 0; k < decimation; k++)
+				sum += ring.samples[(start + i * decimation + k) & (ring.length - 1)].load(std::memory_order_relaxed);
+			frames[i] = sum / decimation;
+			mean += frames[i];
+		}
+		// Sequence check (after copy): oldest copied sample must not have been overwritten meanwhile.
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (ringWriteIndex.load(std::memory_order_relaxed) - start > ring.length)
+			return -1.0f;
+		mean /= 2 * METRIKS_PITCH_WINDOW;
+		double energy = 0.0;
+		for (int i = 0; i < 2 * METRIKS_PITCH_WINDOW; i++) {
+			frames[i] -= mean;
+			energy += (double)(frames[i]) * frames[i];
+		}
+		if (energy < 2 * METRIKS_PITCH_WINDOW * 1e-4)
+			return 0.0f; // Silence (below 10 mV RMS).
+		// Autocorrelation (first window against both windows), as product of spectrums (zero-padded, no circular overlap).
+		for (int i = 0; i < METRIKS_PITCH_FFT; i++) {
+			window[i] = (i < METRIKS_PITCH_WINDOW) ? frames[i] : 0.0f;
+			frame[i] = (i < 2 * METRIKS_PITCH_WINDOW) ? frames[i] : 0.0f;
+		}
+		fft.rfft(window, spectrumWindow);
+		fft.rfft(frame, spectrumFrame);
+		// Ordered spectrums: DC and Nyquist (real) first, then real/imaginary pairs. Product is conj(window) x frame.
+		spectrumWindow[0] *= spectrumFrame[0];
+		spectrumWindow[1] *= spectrumFrame[1];
+		for (int i = 2; i < METRIKS_PITCH_FFT; i += 2) {
+			float re = spectrumWindow[i] * spectrumFrame[i] + spectrumWindow[i + 1] * spectrumFrame[i + 1];
+			float im = spectrumWindow[i] * spectrumFrame[i + 1] - spectrumWindow[i + 1] * spectrumFrame[i];
+			spectrumWindow[i] = re;
+			spectrumWindow[i + 1] = im;
+		}
+		fft.irfft(spectrumWindow, correlation);
+		fft.scale(correlation);
+		// Difference function (from energies and autocorrelation), then cumulative mean normalized difference.
+		double energyFirst = 0.0;
+		for (int i = 0; i < METRIKS_PITCH_WINDOW; i++)
+			energyFirst += (double)(frames[i]) * frames[i];
+		double energyLag = energyFirst;
+		double runningSum = 0.0;
+		differences[0] = 0.0f;
+		normalized[0] = 1.0f;
+		for (int tau = 1; tau < METRIKS_PITCH_WINDOW; tau++) {
+			energyLag += (double)(frames[tau + METRIKS_PITCH_WINDOW - 1]) * frames[tau + METRIKS_PITCH_WINDOW - 1] - (double)(frames[tau - 1]) * frames[tau - 1];
+			double difference = std::max(0.0, energyFirst + energyLag - 2.0 * correlation[tau]);
+			differences[tau] = difference;
+			runningSum += difference;
+			normalized[tau] = (runningSum > 0.0) ? (float)(difference * tau / runningSum) : 1.0f;
+		}
+		// Absolute threshold: first dip below threshold (then its local minimum), otherwise global minimum if periodic enough.
+		int tauMin = std::max(2, (int)(rate / 5000.0f));
+		int tau = -1;
+		for (int t = tauMin; t < METRIKS_PITCH_WINDOW - 1; t++)
+			if (normalized[t] < 0.15f) {
+				while ((t + 1 < METRIKS_PITCH_WINDOW - 1) && (normalized[t + 1] < normalized[t]))
+					t++;
+				tau = t;
+				break;
+			}
+		if (tau < 0) {
+			tau = tauMin;
+			for (int t = tauMin + 1; t < METRIKS_PITCH_WINDOW - 1; t++)
+				if (normalized[t] < normalized[tau])
+					tau = t;
+			if (normalized[tau] > 0.3f)
+				return 0.0f; // Not periodic (noise).
+		}
+		// Parabolic interpolation of period (on difference function).
+		float period = tau;
+		float denominator = differences[tau - 1] - 2.0f * differences[tau] + differences[tau + 1];
+		if (denominator > 0.0f)
+			period += 0.5f * (differences[tau - 1] - differences[tau + 1]) / denominator;
+		return rate / period;
+	}
+};
+
+// Frequency Counter: periods are measured between consecutive rising threshold crossings of input signal, then averaged over gate
+// time. Incremental (O(1) per sample): only the sum of whole periods, and their number, are accumulated during the gate.
+struct MetriksFrequencyCounter {
+	// Analysis mode (0: V/oct voltage to frequency, 1: zero-crossings at sample positions, 2: interpolated zero-crossings, 3: advanced,
+	// interpolated crossings of signal DC offset, for unipolar signals).
+	int analysisMode = 0;
+	float sampleRate = 44100.0f;
+	// Gate time, and timeout (no period during timeout means no signal), in samples.
+	int gateSamples = 44100;
+	int timeoutSamples = 441000;
+	// Hysteresis (in volts) below threshold, to arm the next crossing (noisy signals).
+	float hysteresis = 0.02f;
+	// Previous sample, and signal DC offset (one-pole lowpass), used by advanced mode as threshold.
+	float previousVoltage = 0.0f;
+	float dcOffset = 0.0f;
+	float dcOffsetCoef = 0.0001f;
+	// Crossing is armed (signal went below threshold), and a first crossing was found (periods can be measured).
+	bool bArmed = false;
+	bool bCrossed = false;
+	// Samples (fractional) since last crossing.
+	double samplesSinceCrossing = 0.0;
+	// Accumulators during current gate: sum of periods (in samples) and their number, or sum of voltages (V/oct mode).
+	double periodsSum = 0.0;
+	int periods = 0;
+	double voltagesSum = 0.0;
+	int elapsedSamples = 0;
+	// Last measured frequency (Hz), 0 if no signal.
+	float frequency = 0.0f;
+
+	void setGate(float gateTime, float givenSampleRate) {
+		sampleRate = givenSampleRate;
+		gateSamples = std::max(1, (int)(gateTime * sampleRate));
+		timeoutSamples = std::max(gateSamples, (int)(10.0f * sampleRate));
+		dcOffsetCoef = 1.0f - std::exp(-1.0f / (0.5f * sampleRate)); // DC offset time constant: 0.5 second.
+		restart();
+	}
+
+	// Restart measure (eg after mode change), last frequency remains displayed until next gate.
+	void restart() {
+		bArmed = false;
+		bCrossed = false;
+		samplesSinceCrossing = 0.0;
+		periodsSum = 0.0;
+		periods = 0;
+		voltagesSum = 0.0;
+		elapsedSamples = 0;
+	}
+
+	// Processing one sample, returns true when a new frequency is measured (end of gate, or timeout).
+	bool process(float voltage) {
+		elapsedSamples++;
+		if (analysisMode == 0) {
+			// V/oct: voltages are averaged during gate, then converted to frequency (0V is C4).
+			voltagesSum += voltage;
+			if (elapsedSamples < gateSamples)
+				return false;
+			frequency = dsp::FREQ_C4 * std::pow(2.0f, (float)(voltagesSum / elapsedSamples));
+			voltagesSum = 0.0;
+			elapsedSamples = 0;
+			return true;
+		}
+		float threshold = 0.0f;
+		if (analysisMode == 3) {
+			threshold = dcOffset;
+			dcOffset += dcOffsetCoef * (voltage - dcOffset);
+		}
+		samplesSinceCrossing += 1.0;
+		if (voltage < threshold - hysteresis)
+			bArmed = true;
+			else if (bArmed && (voltage >= threshold)) {
+				// Rising crossing, between previous sample (below threshold) and current sample: interpolated position (in samples ago).
+				bArmed = false;
+				double crossingAgo = (analysisMode == 1) ? 0.0 : 1.0 - (double)(threshold - previousVoltage) / (double)(voltage - previousVoltage);
+				if (bCrossed) {
+					periodsSum += samplesSinceCrossing - crossingAgo;
+					periods++;
+				}
+				bCrossed = true;
+				samplesSinceCrossing = crossingAgo;
+			}
+		previousVoltage = voltage;
+		if (elapsedSamples < gateSamples)
+			return false;
+		if (periods > 0) {
+			// End of gate: average frequency (incomplete period is kept for next gate).
+			frequency = (float)((double)(periods) * sampleRate / periodsSum);
+			periodsSum = 0.0;
+			periods = 0;
+			elapsedSamples = 0;
+			return true;
+		}
+		if (elapsedSamples >= timeoutSamples) {
+			// No period during timeout: no signal (or frequency too low).
+			frequency = 0.0f;
+			bCrossed = false;
+			elapsedSamples = 0;
+			return true;
+		}
+		return false;
+	}
+};
+
+// BPM Meter: inter-onset intervals (in samples) of incoming clock are kept into a fixed-size ring buffer, and summed over one beat
+// (PPQN intervals, this way swing is cancelled), then beat lengths are median filtered (jitter). No allocation, constant cost per
+// sample (median is done on clock pulses only, over a fixed number of beats).
+#define METRIKS_BPM_MAX_PPQN 24
+#define METRIKS_BPM_BEATS 9
+struct MetriksBPMMeter {
+	// Clock pulses per quarter note (1, 2, 4 or 24).
+	int ppqn = 1;
+	float sampleRate = 44100.0f;
+	// Samples since last clock pulse (once a first clock pulse was received), and timeout (in samples) without clock pulse.
+	int samplesSinceOnset = 0;
+	bool bOnset = false;
+	int timeoutSamples = 220500;
+	// Last inter-onset intervals (ring buffer), their number (upto PPQN), and running sum of last PPQN intervals (one beat).
+	int intervals[METRIKS_BPM_MAX_PPQN] = {};
+	int intervalIndex = 0;
+	int intervalCount = 0;
+	int beatSamples = 0;
+	// Last beat lengths (ring buffer), and their number, used by median filter.
+	int beats[METRIKS_BPM_BEATS] = {};
+	int beatIndex = 0;
+	int beatCount = 0;
+	// Last measured tempo (BPM), 0 if no clock.
+	float bpm = 0.0f;
+
+	void setPPQN(int givenPPQN, float givenSampleRate) {
+		ppqn = clamp(givenPPQN, 1, METRIKS_BPM_MAX_PPQN);
+		sampleRate = givenSampleRate;
+		timeoutSamples = (int)(5.0f * sampleRate); // No clock pulse during 5 seconds: clock is lost.
+		restart();
+	}
+
+	void restart() {
+		bOnset = false;
+		samplesSinceOnset = 0;
+		intervalIndex = 0;
+		intervalCount = 0;
+		beatSamples = 0;
+		beatIndex = 0;
+		beatCount = 0;
+		bpm = 0.0f;
+	}
+
+	// Processing one sample (bRisingEdge is true on clock pulse).
+	void process(bool bRisingEdge) {
+		if (bOnset)
+			samplesSinceOnset++;
+		if (!bRisingEdge) {
+			if (bOnset && (samplesSinceOnset >= timeoutSamples))
+				restart(); // Clock is lost.
+			return;
+		}
+		if (bOnset) {
+			// New inter-onset interval: running sum of last PPQN intervals (oldest one is removed once ring buffer is full).
+			if (intervalCount == ppqn)
+				beatSamples -= intervals[intervalIndex];
+				else intervalCount++;
+			intervals[intervalIndex] = samplesSinceOnset;
+			beatSamples += samplesSinceOnset;
+			intervalIndex = (intervalIndex + 1) % ppqn;
+			if (intervalCount == ppqn) {
+				// One complete beat: median of last beat lengths.
+				beats[beatIndex] = beatSamples;
+				beatIndex = (beatIndex + 1) % METRIKS_BPM_BEATS;
+				if (beatCount < METRIKS_BPM_BEATS)
+					beatCount++;
+				int sorted[METRIKS_BPM_BEATS];
+				std::copy(beats, beats + beatCount, sorted);
+				std::nth_element(sorted, sorted + beatCount / 2, sorted + beatCount);
+				bpm = 60.0f * sampleRate / (float)(sorted[beatCount / 2]);
+			}
+		}
+		bOnset = true;
+		samplesSinceOnset = 0;
+	}
+};
 
 // Module structure.
 struct MetriksModule : Module {
@@ -47,7 +763,7 @@ struct MetriksModule : Module {
 	int Model;
 	int portMetal = 0; // used to select silver or gold jacks.
 
-	// Mode (0: voltmeter, 1: CV Tuner, 2: frequency counter, 2: BPM meter, 4: peak counter).
+	// Mode (0: voltmeter, 1: CV Tuner, 2: frequency counter, 2: BPM meter, 4: peak counter, 5: poly meter).
 	bool bChangingMode = false; // true during mode transition, false otherwise.
 	int Mode = 0; // Current mode.
 	int _Mode = 0; // Its old/previous state (required for Preset management).
@@ -69,96 +785,48 @@ struct MetriksModule : Module {
 		METRIKS_FREQCOUNTER,
 		METRIKS_BPMMETER,
 		METRIKS_PEAKCOUNTER,
+		METRIKS_POLYMETER,
 		METRIKS_NUM_MODES
 	};
 
-	const int tb_OptionNumPerMode[METRIKS_NUM_MODES] = {2, 2, 1, 0, 1}; // For each mode, number of possible option(s). BPM meter doesn't have option.
+	const int tb_OptionNumPerMode[METRIKS_NUM_MODES] = {3, 3, 2, 1, 1, 2}; // For each mode, number of possible option(s).
 	std::string tb_OptionID[METRIKS_NUM_MODES][4]; // Will be initialized later (from module constructor).
 	int tb_ParamNumPerOpt[METRIKS_NUM_MODES][4]; // Will be initialized later (from module constructor).
-	std::string tb_OptParameter[METRIKS_NUM_MODES][4][4]; // Will be initialized later (from module constructor).
-	float tb_OptParameterXPos[METRIKS_NUM_MODES][4][4]; // Message positions (on line 2 of DMD). Will be initialized later (from module constructor).
-	int currentParameter[METRIKS_NUM_MODES][4] = {{0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {17, 0, 0, 0}}; // Must be initialized here, to avoid potential crash on instanciate!
-	int _currentParameter[METRIKS_NUM_MODES][4] = {{0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {17, 0, 0, 0}}; // Must be initialized here, to avoid potential crash on instanciate!
-
-	// Frequencies tables used by CV Tuner feature. Will are initialized later (from module constructor).
-	double tb_FreqNote_Center[132] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0};
-
-	double tb_FreqNote_LP_LimL[132] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0};
-
-	double tb_FreqNote_LP_LimH[132] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0};
-
-	double tb_FreqNote_MP_LimL[132] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0};
-
-	double tb_FreqNote_MP_LimH[132] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0};
-
-	double tb_FreqNote_HP_LimL[132] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0};
-
-	double tb_FreqNote_HP_LimH[132] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 
-																		0.0, 0.0, 0.0, 0.0};
+	std::string tb_OptParameter[METRIKS_NUM_MODES][4][METRIKS_MAX_PARAMS]; // Will be initialized later (from module constructor).
+	float tb_OptParameterXPos[METRIKS_NUM_MODES][4][METRIKS_MAX_PARAMS]; // Message positions (on line 2 of DMD). Will be initialized later (from module constructor).
+	int currentParameter[METRIKS_NUM_MODES][4] = {{0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {17, 0, 0, 0}, {0, 0, 0, 0}}; // Must be initialized here, to avoid potential crash on instanciate!
+	int _currentParameter[METRIKS_NUM_MODES][4] = {{0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {17, 0, 0, 0}, {0, 0, 0, 0}}; // Must be initialized here, to avoid potential crash on instanciate!
 
 	// CV Tuner variables.
-	std::string tunerBaseNoteName[12] = {"", "", "", "", "", "", "", "", "", "", "", ""}; // Base note names, for now empty, filled later...
-	bool bUpdateNotesTable = true;
-	std::string tunerNote[132];
+	const char (*tunerNote)[8] = metriksNotesTables().notes[0][0]; // Current notes table (shared by all Metriks modules), depending options.
 	char dmdTunerMarker[3] = ""; // CV Tuner only, to display the below/above marker(s).
 	float dmdTunerMarkerPos = 0.0f;
 	bool b_tunrMarkerVisible = false;
 
+	// CV Tuner, audio input: audio thread only writes samples into a lock-free ring buffer (single producer, relaxed atomic samples,
+	// write index is published after the sample), then pitch is detected by a background worker (requested by UI thread, module
+	// widget), and published back as frequency (0 if no pitch). Nothing is allocated until audio input is selected: ring buffer
+	// (sized for current sample rate) is allocated by UI thread into spare slot, once audio thread is using active ring (same
+	// handshake as level metering buffers), and never while worker is analysing it. Worker is started with first ring, detector is
+	// allocated and owned by worker thread, request is guarded by mutex.
+	std::unique_ptr<MetriksPitchRing> pitchRings[2];
+	std::atomic<uint32_t> pitchRingRequest {0}; // Set by audio thread, while audio input is selected (0: never selected).
+	std::atomic<int> pitchRingActive {-1}; // Set by UI thread (-1: not allocated yet).
+	std::atomic<int> pitchRingInUse {-1}; // Set by audio thread, as soon as it's writing into active ring.
+	MetriksPitchRing *pitchRing = nullptr; // Ring written by audio thread.
+	uint32_t pitchRingLength = 4096; // Ring length for current sample rate (audio thread).
+	std::atomic<uint32_t> pitchWriteIndex {0};
+	std::atomic<float> pitchSampleRate {44100.0f};
+	std::atomic<float> pitchFrequency {0.0f};
+	std::thread pitchWorker;
+	std::mutex pitchMutex;
+	std::condition_variable pitchCondition;
+	bool bPitchRequest = false;
+	bool bPitchWorkerExit = false;
+	uint32_t pitchRequestIndex = 0;
+	int pitchRequestRing = -1; // Ring to analyse (requested).
+	int pitchAnalysedRing = -1; // Ring being analysed by worker (-1: worker is idle).
+
 	// Messages displayed on DMD (dot-matrix display), using two lines..
 	char dmdTextMain1[20] = ""; // 20 chars for upper (1st) line.
 	char dmdTextMain2[20] = ""; // 20 chars for lower (2nd) line.
@@ -176,10 +844,33 @@ struct MetriksModule : Module {
 	bool _bActiveINjack = false; // Old/previous IN jack state.
 	float f_InVoltage = 0.0f;
 	float _f_InVoltage = -1.0f; // Old/previous voltage on IN jack.
-	// Used for mix, max, and median.
+	// Used for min, max, median and percentiles (streaming estimates, never stored).
 	float f_VoltageMin = 99999.0f;
 	float f_VoltageMax = -99999.0f;
-	float f_VoltageMed = 0.0f;
+	MetriksP2Quantile vltmMedian {0.5f};
+	MetriksP2Quantile vltmP5 {0.05f};
+	MetriksP2Quantile vltmP95 {0.95f};
+	// Level metering (RMS, mean, crest factor, true-peak), its window time (in seconds), and level metering in progress (restarted when
+	// it wasn't running at previous step).
+	MetriksLevelMeter levelMeter;
+	float vltmWindowTime = 0.3f;
+	bool bLevelRunning = false;
+	// Level metering buffers: allocated by UI thread (module widget) into spare buffers, sized to window length requested by audio
+	// thread (0: level metering was never selected), once audio thread is using active buffers (same handshake as RKD user tables).
+	MetriksLevelBuffers levelBuffers[2];
+	std::atomic<int> levelWindowRequest {0}; // Set by audio thread, while level metering is selected.
+	std::atomic<int> levelBuffersActive {-1}; // Set by UI thread (-1: not allocated yet).
+	std::atomic<int> levelBuffersInUse {-1}; // Set by audio thread, as soon as it's using active buffers.
+	// Voltmeter statistics (median and percentiles) are computed only in voltmeter mode, in progress (restarted when voltmeter mode
+	// is entered again).
+	bool bVltmStatsRunning = false;
+
+	// Poly Meter mode: statistics for all channels, measure in progress (restarted when mode is entered again), displayed channel, and
+	// frames counter for "Scan" (paging) channel option.
+	MetriksPolyStats polyStats;
+	bool bPolyRunning = false;
+	int polyChannel = 0;
+	int polyScanFrames = 0;
 
 	// PLAY/STOP button and related (trigger) port (PLAY/STOP is used for "Pulse Counter" mode only).
 	dsp::SchmittTrigger playButton;
@@ -192,23 +883,46 @@ struct MetriksModule : Module {
 
 	// Number of decimals can be displayed by voltmeter.
 	int vltmDecimals = 2; // Number of decimals used by Voltmeter
-	int _vltmDecimals = -1; // Old/previous number of decimals.
+
+	// Voltmeter reading, as lock-free snapshot: published by audio thread (numeric values only), then formatted by DMD widget at
+	// frame rate. Snapshot is active while voltmeter is measuring (input connected, not changing mode or option), otherwise DMD is
+	// displaying text lines prepared by audio thread.
+	std::atomic<bool> bVltmSnapshot {false};
+	std::atomic<int> vltmSnapshotMetering {0};
+	std::atomic<int> vltmSnapshotDecimals {2};
+	std::atomic<float> vltmSnapshotVoltage {0.0f};
 
 	// Schmitt trigger used to determine frequency. Also used for peak counter mode.
 	dsp::SchmittTrigger inputPort;
 
+	// Frequency Counter mode: measure, gate time (in seconds), and measure in progress (restarted when mode is entered again).
+	MetriksFrequencyCounter frequencyCounter;
+	float fcntGateTime = 1.0f;
+	bool bFcntRunning = false;
+
+	// BPM Meter mode: measure (clock pulses are detected by "inputPort" Schmitt trigger), and measure in progress (restarted when mode
+	// is entered again).
+	MetriksBPMMeter bpmMeter;
+	bool bBpmRunning = false;
+
+	// Display is refreshed at UI rate (not every sample), for modes measuring continuously (eg Frequency Counter).
+	dsp::ClockDivider displayDivider;
+
 	// Used by Peak Counter mode, for peak detection at treshold voltage.
 	int pcntTresholdVoltage = 17;
 	float f_pcntTresholdVoltage = 1.7f;
+	// Peak Counter: number of peaks (64-bit), next peak is armed once voltage is below threshold minus hysteresis (in volts).
+	uint64_t pcntCount = 0;
+	bool bPcntArmed = false;
+	const float pcntHysteresis = 0.1f;
+	// Peak Counter rate (peaks per second), measured over one second windows: count at window start, and elapsed samples.
+	float pcntRate = 0.0f;
+	uint64_t pcntWindowCount = 0;
+	int pcntWindowSamples = 0;
 
 	// Dummy string (used for std::string to char * conversions).
 	std::string _tmpString; // Dummy string.
 
-	// TEMPORARY - used for inoperative mode(s) - MUST BE REMOVED WHEN ALL MODES WORK.
-	bool b_InopMode = false;
-	int ct_InopModeTimer = 0;
-	int i_InopMsgCycling = 0;
-
 	MetriksModule() {
 		// Module constructor.
 		b_dspIsRunning = false; // Will be set true as soon as DSP is running.
@@ -223,9 +937,8 @@ struct MetriksModule : Module {
 		configInput(INPUT_SOURCE, "Signal to analyze");
 		configInput(INPUT_PLAYPAUSE, "Play/Pause");
 		configInput(INPUT_RESET, "Reset");
-		configOutput(OUTPUT_THRU, "Signal");
+		configOutput(OUTPUT_THRU, "Signal (all channels)");
 		configBypass(INPUT_SOURCE, OUTPUT_THRU);
-		b_InopMode = false; // TEMPORARY - false means the mode is operational (totally or partially) - MUST BE REMOVED WHEN ALL MODES WORK.
 		bChangingMode = false;
 		ct_SwitchedMode = 0;
 		bChangingOption = false;
@@ -235,11 +948,11 @@ struct MetriksModule : Module {
 		bPeakCounterIsPlaying = false;
 		for (int i = 0; i < METRIKS_NUM_MODES; i++)
 			for (int j = 0; j < 4; j++)
-				for (int k = 0; k < 4; k++)
+				for (int k = 0; k < METRIKS_MAX_PARAMS; k++)
 					tb_OptParameterXPos[i][j][k] = 0.0f; // Horizontal positions (display on line 2 of DMD). Default 0.0f, used will are set just below.
 		// Tables used by Voltmeter mode.
 		tb_OptionID[METRIKS_VOLTMETER][0] = "Metering";
-		tb_ParamNumPerOpt[METRIKS_VOLTMETER][0] = 4;
+		tb_ParamNumPerOpt[METRIKS_VOLTMETER][0] = METRIKS_VLTM_METERINGS;
 		tb_OptParameter[METRIKS_VOLTMETER][0][0] = "Realtime";
 		tb_OptParameterXPos[METRIKS_VOLTMETER][0][0] = 9.17f;
 		tb_OptParameter[METRIKS_VOLTMETER][0][1] = "Minimum";
@@ -248,6 +961,16 @@ struct MetriksModule : Module {
 		tb_OptParameterXPos[METRIKS_VOLTMETER][0][2] = 12.0f;
 		tb_OptParameter[METRIKS_VOLTMETER][0][3] = "Median";
 		tb_OptParameterXPos[METRIKS_VOLTMETER][0][3] = 18.6f;
+		tb_OptParameter[METRIKS_VOLTMETER][0][4] = "Perc. 5%";
+		tb_OptParameterXPos[METRIKS_VOLTMETER][0][4] = getCenteredDMD(tb_OptParameter[METRIKS_VOLTMETER][0][4]);
+		tb_OptParameter[METRIKS_VOLTMETER][0][5] = "Perc. 95%";
+		tb_OptParameterXPos[METRIKS_VOLTMETER][0][5] = getCenteredDMD(tb_OptParameter[METRIKS_VOLTMETER][0][5]);
+		tb_OptParameter[METRIKS_VOLTMETER][0][6] = "RMS";
+		tb_OptParameter[METRIKS_VOLTMETER][0][7] = "Mean";
+		tb_OptParameter[METRIKS_VOLTMETER][0][8] = "Crest F.";
+		tb_OptParameter[METRIKS_VOLTMETER][0][9] = "True Peak";
+		for (int k = 6; k < METRIKS_VLTM_METERINGS; k++)
+			tb_OptParameterXPos[METRIKS_VOLTMETER][0][k] = getCenteredDMD(tb_OptParameter[METRIKS_VOLTMETER][0][k]);
 		tb_OptionID[METRIKS_VOLTMETER][1] = "Decimals";
 		tb_ParamNumPerOpt[METRIKS_VOLTMETER][1] = 4;
 		tb_OptParameter[METRIKS_VOLTMETER][1][0] = "2";
@@ -258,12 +981,14 @@ struct MetriksModule : Module {
 		tb_OptParameterXPos[METRIKS_VOLTMETER][1][2] = 41.19f;
 		tb_OptParameter[METRIKS_VOLTMETER][1][3] = "1";
 		tb_OptParameterXPos[METRIKS_VOLTMETER][1][3] = 41.19f;
-		tb_OptionID[METRIKS_VOLTMETER][2] = ""; // Not used.
-		tb_ParamNumPerOpt[METRIKS_VOLTMETER][2] = 0;
-		tb_OptParameter[METRIKS_VOLTMETER][2][0] = ""; // Not used.
-		tb_OptParameter[METRIKS_VOLTMETER][2][1] = ""; // Not used.
-		tb_OptParameter[METRIKS_VOLTMETER][2][2] = ""; // Not used.
-		tb_OptParameter[METRIKS_VOLTMETER][2][3] = ""; // Not used.
+		tb_OptionID[METRIKS_VOLTMETER][2] = "Window"; // Used by RMS, mean, crest factor and true-peak.
+		tb_ParamNumPerOpt[METRIKS_VOLTMETER][2] = 4;
+		tb_OptParameter[METRIKS_VOLTMETER][2][0] = "0.3 Sec.";
+		tb_OptParameter[METRIKS_VOLTMETER][2][1] = "1 Second";
+		tb_OptParameter[METRIKS_VOLTMETER][2][2] = "3 Sec.";
+		tb_OptParameter[METRIKS_VOLTMETER][2][3] = "0.05 Sec.";
+		for (int k = 0; k < 4; k++)
+			tb_OptParameterXPos[METRIKS_VOLTMETER][2][k] = getCenteredDMD(tb_OptParameter[METRIKS_VOLTMETER][2][k]);
 		tb_OptionID[METRIKS_VOLTMETER][3] = ""; // Not used.
 		tb_ParamNumPerOpt[METRIKS_VOLTMETER][3] = 0;
 		tb_OptParameter[METRIKS_VOLTMETER][3][0] = ""; // Not used.
@@ -287,12 +1012,12 @@ struct MetriksModule : Module {
 		tb_OptParameterXPos[METRIKS_CVTUNER][1][1] = 12.94f;
 		tb_OptParameter[METRIKS_CVTUNER][1][2] = ""; // Not used.
 		tb_OptParameter[METRIKS_CVTUNER][1][3] = ""; // Not used.
-		tb_OptionID[METRIKS_CVTUNER][2] = ""; // Not used.
-		tb_ParamNumPerOpt[METRIKS_CVTUNER][2] = 1; // Not used.
-		tb_OptParameter[METRIKS_CVTUNER][2][0] = ""; // Not used.
-		tb_OptParameter[METRIKS_CVTUNER][2][1] = ""; // Not used.
-		tb_OptParameter[METRIKS_CVTUNER][2][2] = ""; // Not used.
-		tb_OptParameter[METRIKS_CVTUNER][2][3] = ""; // Not used.
+		tb_OptionID[METRIKS_CVTUNER][2] = "Input";
+		tb_ParamNumPerOpt[METRIKS_CVTUNER][2] = 2;
+		tb_OptParameter[METRIKS_CVTUNER][2][0] = "V/Oct CV";
+		tb_OptParameter[METRIKS_CVTUNER][2][1] = "Audio";
+		for (int k = 0; k < 2; k++)
+			tb_OptParameterXPos[METRIKS_CVTUNER][2][k] = getCenteredDMD(tb_OptParameter[METRIKS_CVTUNER][2][k]);
 		tb_OptionID[METRIKS_CVTUNER][3] = ""; // Not used.
 		tb_ParamNumPerOpt[METRIKS_CVTUNER][3] = 0;
 		tb_OptParameter[METRIKS_CVTUNER][3][0] = ""; // Not used.
@@ -310,12 +1035,14 @@ struct MetriksModule : Module {
 		tb_OptParameterXPos[METRIKS_FREQCOUNTER][0][2] = 1.64f;
 		tb_OptParameter[METRIKS_FREQCOUNTER][0][3] = "Advanced";
 		tb_OptParameterXPos[METRIKS_FREQCOUNTER][0][3] = 7.29f;
-		tb_OptionID[METRIKS_FREQCOUNTER][1] = ""; // Not used.
-		tb_ParamNumPerOpt[METRIKS_FREQCOUNTER][1] = 0;
-		tb_OptParameter[METRIKS_FREQCOUNTER][1][0] = ""; // Not used.
-		tb_OptParameter[METRIKS_FREQCOUNTER][1][1] = ""; // Not used.
-		tb_OptParameter[METRIKS_FREQCOUNTER][1][2] = ""; // Not used.
-		tb_OptParameter[METRIKS_FREQCOUNTER][1][3] = ""; // Not used.
+		tb_OptionID[METRIKS_FREQCOUNTER][1] = "Gate Time";
+		tb_ParamNumPerOpt[METRIKS_FREQCOUNTER][1] = 4;
+		tb_OptParameter[METRIKS_FREQCOUNTER][1][0] = "1 Second";
+		tb_OptParameter[METRIKS_FREQCOUNTER][1][1] = "10 Sec.";
+		tb_OptParameter[METRIKS_FREQCOUNTER][1][2] = "0.01 Sec.";
+		tb_OptParameter[METRIKS_FREQCOUNTER][1][3] = "0.1 Sec.";
+		for (int k = 0; k < 4; k++)
+			tb_OptParameterXPos[METRIKS_FREQCOUNTER][1][k] = getCenteredDMD(tb_OptParameter[METRIKS_FREQCOUNTER][1][k]);
 		tb_OptionID[METRIKS_FREQCOUNTER][2] = ""; // Not used.
 		tb_ParamNumPerOpt[METRIKS_FREQCOUNTER][2] = 0;
 		tb_OptParameter[METRIKS_FREQCOUNTER][2][0] = ""; // Not used.
@@ -328,13 +1055,15 @@ struct MetriksModule : Module {
 		tb_OptParameter[METRIKS_FREQCOUNTER][3][1] = ""; // Not used.
 		tb_OptParameter[METRIKS_FREQCOUNTER][3][2] = ""; // Not used.
 		tb_OptParameter[METRIKS_FREQCOUNTER][3][3] = ""; // Not used.
-		// Tables used by BPM Meter mode (for now, BPM Meter mode doesn't have options).
-		tb_OptionID[METRIKS_BPMMETER][0] = ""; // Not used.
-		tb_ParamNumPerOpt[METRIKS_BPMMETER][0] = 0;
-		tb_OptParameter[METRIKS_BPMMETER][0][0] = ""; // Not used.
-		tb_OptParameter[METRIKS_BPMMETER][0][1] = ""; // Not used.
-		tb_OptParameter[METRIKS_BPMMETER][0][2] = ""; // Not used.
-		tb_OptParameter[METRIKS_BPMMETER][0][3] = ""; // Not used.
+		// Tables used by BPM Meter mode.
+		tb_OptionID[METRIKS_BPMMETER][0] = "Clock";
+		tb_ParamNumPerOpt[METRIKS_BPMMETER][0] = 4;
+		tb_OptParameter[METRIKS_BPMMETER][0][0] = "1 PPQN";
+		tb_OptParameter[METRIKS_BPMMETER][0][1] = "2 PPQN";
+		tb_OptParameter[METRIKS_BPMMETER][0][2] = "4 PPQN";
+		tb_OptParameter[METRIKS_BPMMETER][0][3] = "24 PPQN";
+		for (int k = 0; k < 4; k++)
+			tb_OptParameterXPos[METRIKS_BPMMETER][0][k] = getCenteredDMD(tb_OptParameter[METRIKS_BPMMETER][0][k]);
 		tb_OptionID[METRIKS_BPMMETER][1] = ""; // Not used.
 		tb_ParamNumPerOpt[METRIKS_BPMMETER][1] = 0;
 		tb_OptParameter[METRIKS_BPMMETER][1][0] = ""; // Not used.
@@ -378,12 +1107,123 @@ struct MetriksModule : Module {
 		tb_OptParameter[METRIKS_PEAKCOUNTER][3][1] = ""; // Not used.
 		tb_OptParameter[METRIKS_PEAKCOUNTER][3][2] = ""; // Not used.
 		tb_OptParameter[METRIKS_PEAKCOUNTER][3][3] = ""; // Not used.
+		// Tables used by Poly Meter mode.
+		tb_OptionID[METRIKS_POLYMETER][0] = "Statistic";
+		tb_ParamNumPerOpt[METRIKS_POLYMETER][0] = 3;
+		tb_OptParameter[METRIKS_POLYMETER][0][0] = "Minimum";
+		tb_OptParameter[METRIKS_POLYMETER][0][1] = "Maximum";
+		tb_OptParameter[METRIKS_POLYMETER][0][2] = "RMS";
+		for (int k = 0; k < 3; k++)
+			tb_OptParameterXPos[METRIKS_POLYMETER][0][k] = getCenteredDMD(tb_OptParameter[METRIKS_POLYMETER][0][k]);
+		tb_OptionID[METRIKS_POLYMETER][1] = "Channel";
+		tb_ParamNumPerOpt[METRIKS_POLYMETER][1] = 17;
+		for (int k = 0; k < 16; k++)
+			tb_OptParameter[METRIKS_POLYMETER][1][k] = "Ch. " + std::to_string(k + 1);
+		tb_OptParameter[METRIKS_POLYMETER][1][16] = "Scan"; // Next channel every second.
+		for (int k = 0; k < 17; k++)
+			tb_OptParameterXPos[METRIKS_POLYMETER][1][k] = getCenteredDMD(tb_OptParameter[METRIKS_POLYMETER][1][k]);
+		tb_OptionID[METRIKS_POLYMETER][2] = ""; // Not used.
+		tb_ParamNumPerOpt[METRIKS_POLYMETER][2] = 0;
+		tb_OptionID[METRIKS_POLYMETER][3] = ""; // Not used.
+		tb_ParamNumPerOpt[METRIKS_POLYMETER][3] = 0;
 		// Model.
 		Model = rack::settings::preferDarkPanels ? 2 : 0; // Model: assuming default is "Creamy" or "Absolute Night" (depending "Use dark panels if available" option, from "View" menu).
 		// Get current engine sample rate.
 		onSampleRateChange();
-		// Set up frequencies tables for CV Tuner mode.
-		setTunerFreqTables();
+	}
+
+	~MetriksModule() {
+		// Stopping pitch detection worker (if started).
+		if (!pitchWorker.joinable())
+			return;
+		{
+			std::lock_guard<std::mutex> lock(pitchMutex);
+			bPitchWorkerExit = true;
+		}
+		pitchCondition.notify_one();
+		pitchWorker.join();
+	}
+
+	// Pitch detection worker (background thread): waiting for a request, then analysing last samples of requested ring buffer.
+	void pitchWorkerLoop() {
+		// Detector (FFT and frames buffers) is allocated by worker thread itself.
+		std::unique_ptr<MetriksPitchDetector> pitchDetector(new MetriksPitchDetector());
+		std::unique_lock<std::mutex> lock(pitchMutex);
+		while (true) {
+			pitchCondition.wait(lock, [this] { return bPitchRequest || bPitchWorkerExit; });
+			if (bPitchWorkerExit)
+				return;
+			bPitchRequest = false;
+			uint32_t writeIndex = pitchRequestIndex;
+			pitchAnalysedRing = pitchRequestRing;
+			MetriksPitchRing &ring = *pitchRings[pitchAnalysedRing];
+			lock.unlock();
+			float frequency = pitchDetector->analyse(ring, pitchWriteIndex, writeIndex, pitchSampleRate.load());
+			if (frequency >= 0.0f)
+				pitchFrequency.store(frequency); // Otherwise, lapped frame is discarded (previous frequency is kept).
+			lock.lock();
+			pitchAnalysedRing = -1;
+		}
+	}
+
+	// Level metering buffers (from UI thread): allocated into spare buffers when audio thread requests another window length, only
+	// once audio thread is using active buffers (otherwise, retried on next step). Previous buffers are released once unused.
+	void allocateLevelBuffers() {
+		int windowLength = levelWindowRequest.load(std::memory_order_relaxed);
+		int active = levelBuffersActive.load();
+		if ((windowLength == 0) || (active != levelBuffersInUse.load()))
+			return;
+		int spare = (active < 0) ? 0 : 1 - active;
+		if ((active >= 0) && (levelBuffers[active].capacity == windowLength)) {
+			if (levelBuffers[spare].capacity != 0)
+				levelBuffers[spare].release();
+			return;
+		}
+		levelBuffers[spare].allocate(windowLength);
+		levelBuffersActive.store(spare);
+	}
+
+	// Pitch detection ring buffer (from UI thread): allocated into spare slot when audio thread requests another ring length, only
+	// once audio thread is writing into active ring, and while worker isn't analysing spare ring (otherwise, retried on next step).
+	// Previous ring is released once unused.
+	void allocatePitchRing() {
+		uint32_t length = pitchRingRequest.load(std::memory_order_relaxed);
+		int active = pitchRingActive.load();
+		if ((length == 0) || (active != pitchRingInUse.load()))
+			return;
+		int spare = (active < 0) ? 0 : 1 - active;
+		{
+			std::lock_guard<std::mutex> lock(pitchMutex);
+			if ((pitchAnalysedRing == spare) || (bPitchRequest && (pitchRequestRing == spare)))
+				return;
+		}
+		if ((active >= 0) && (pitchRings[active]->length == length)) {
+			pitchRings[spare].reset();
+			return;
+		}
+		pitchRings[spare].reset(new MetriksPitchRing(length));
+		pitchRingActive.store(spare);
+	}
+
+	// Requesting pitch detection (from UI thread), if new samples were written by audio thread since previous request. Worker is
+	// started with first ring buffer (allocated only once audio input is selected).
+	void requestPitchAnalysis() {
+		allocatePitchRing();
+		int ring = pitchRingInUse.load();
+		if (ring < 0)
+			return;
+		if (!pitchWorker.joinable())
+			pitchWorker = std::thread(&MetriksModule::pitchWorkerLoop, this);
+		uint32_t writeIndex = pitchWriteIndex.load(std::memory_order_acquire);
+		{
+			std::lock_guard<std::mutex> lock(pitchMutex);
+			if (writeIndex == pitchRequestIndex)
+				return;
+			pitchRequestIndex = writeIndex;
+			pitchRequestRing = ring;
+			bPitchRequest = true;
+		}
+		pitchCondition.notify_one();
 	}
 
 	// Invoked (as event) from Initialize command via module's context menu (also Ctrl+I, Command+I on Macinthosh) to reset the module.
@@ -402,7 +1242,6 @@ struct MetriksModule : Module {
 				setMetriksParameters(i, j);
 			}
 		_Mode = Mode;
-		b_InopMode = false; // TEMPORARY - false means the mode is operational (totally or partially) - MUST BE REMOVED WHEN ALL MODES WORK.
 		bChangingMode = false;
 		ct_SwitchedMode = 0;
 		bChangingOption = false;
@@ -412,10 +1251,8 @@ struct MetriksModule : Module {
 		lights[LED_OPTIONS].setBrightness(0.0f);
 		// Peak Counter isn't running.
 		bPeakCounterIsPlaying = false;
-		// Reset minimum, maximum and median voltages (voltmeter mode).
-		f_VoltageMin = f_InVoltage;
-		f_VoltageMax = f_InVoltage;
-		f_VoltageMed = f_InVoltage;
+		// Reset minimum, maximum, median and percentiles voltages (voltmeter mode).
+		resetVoltmeterStats(f_InVoltage);
 		// By doing this, the second line of DMD will be refreshed.
 		_f_InVoltage = f_InVoltage + 1.0f;
 	}
@@ -423,18 +1260,19 @@ struct MetriksModule : Module {
 	// Invoked (as event) when Engine's Sample rate is changed from VCV Rack menu.
 	void onSampleRateChange() override {
 		sampleRate = APP->engine->getSampleRate();
-	}
-
-	// Custom function to round a float-type at given decimals. Using internally "double", for best precision!
-	inline float roundp(double f, int prec) {
-		return round(f * (double)(pow(10, prec))) / (double)(pow(10, prec));
+		frequencyCounter.setGate(fcntGateTime, sampleRate);
+		bpmMeter.setPPQN(bpmMeter.ppqn, sampleRate);
+		displayDivider.setDivision(std::max(1, (int)(sampleRate / 60.0f))); // About 60 refreshes per second.
+		levelMeter.setWindow(vltmWindowTime, sampleRate);
+		polyStats.setBlock(sampleRate);
+		pitchSampleRate.store(sampleRate);
+		pitchRingLength = metriksPitchRingLength(sampleRate);
 	}
 
 	void setMetriksParameters(int i_Mode, int i_Opt) {
 		if (currentParameter[i_Mode][i_Opt] != _currentParameter[i_Mode][i_Opt]) {
 			// Suddently (uncontroled) changed parameter, for example via Preset load or copy/paste accross Metriks modules.
 			_Mode = Mode;
-			b_InopMode = false; // TEMPORARY - false means the mode is operational (totally or partially) - MUST BE REMOVED WHEN ALL MODES WORK.
 			bChangingMode = false;
 			ct_SwitchedMode = 0;
 			bChangingOption = false;
@@ -472,6 +1310,16 @@ struct MetriksModule : Module {
 							 vltmDecimals = 1;
 					}
 				}
+				else if ((i_Opt == 0) && (currentParameter[METRIKS_VOLTMETER][0] >= METRIKS_VLTM_LEVEL)) {
+					// Level metering (RMS, mean, crest factor or true-peak).
+					levelMeter.setMetering(clamp(currentParameter[METRIKS_VOLTMETER][0], METRIKS_VLTM_LEVEL, METRIKS_VLTM_METERINGS - 1) - METRIKS_VLTM_LEVEL);
+				}
+				else if (i_Opt == 2) {
+					// Window (level metering).
+					static const float windowTimes[4] = {0.3f, 1.0f, 3.0f, 0.05f};
+					vltmWindowTime = windowTimes[clamp(currentParameter[METRIKS_VOLTMETER][2], 0, 3)];
+					levelMeter.setWindow(vltmWindowTime, sampleRate);
+				}
 				break;
 			case METRIKS_CVTUNER:
 				// CV Tuner mode.
@@ -479,8 +1327,38 @@ struct MetriksModule : Module {
 				makeNotesTables();
 				break;
 			case METRIKS_FREQCOUNTER:
+				// Frequency Counter mode.
+				if (i_Opt == 0)
+					frequencyCounter.analysisMode = currentParameter[METRIKS_FREQCOUNTER][0]; // Analysis mode.
+				else if (i_Opt == 1) {
+					// Gate time...
+					switch (currentParameter[METRIKS_FREQCOUNTER][1]) {
+						case 0:
+							 // 1 second (default).
+							 fcntGateTime = 1.0f;
+						break;
+						case 1:
+							 // 10 seconds.
+							 fcntGateTime = 10.0f;
+						break;
+						case 2:
+							 // 0.01 second.
+							 fcntGateTime = 0.01f;
+						break;
+						case 3:
+							 // 0.1 second.
+							 fcntGateTime = 0.1f;
+					}
+					frequencyCounter.setGate(fcntGateTime, sampleRate);
+				}
+				frequencyCounter.restart();
 				break;
 			case METRIKS_BPMMETER:
+				// BPM Meter mode: clock resolution (PPQN).
+				if (i_Opt == 0) {
+					static const int bpmPPQN[4] = {1, 2, 4, 24};
+					bpmMeter.setPPQN(bpmPPQN[clamp(currentParameter[METRIKS_BPMMETER][0], 0, 3)], sampleRate);
+				}
 				break;
 			case METRIKS_PEAKCOUNTER:
 				// Peak Counter mode.
@@ -493,96 +1371,11 @@ struct MetriksModule : Module {
 		}
 	}
 
-	// Custom method to make current notes table, depending "Notation" and "Sharps/Flats" parameters (CV Tuner mode).
+	// Custom method to select current notes table, depending "Notation" and "Sharps/Flats" parameters (CV Tuner mode).
 	void makeNotesTables() {
-		if (currentParameter[METRIKS_CVTUNER][0] == 0) {
-			// English (international) notation (C, D, E,...B).
-			tb_OptionID[METRIKS_CVTUNER][2] = "A4 Pitch";
-			if (currentParameter[METRIKS_CVTUNER][1] == 0) {
-				// Sharps.
-				tunerBaseNoteName[0] = "C";
-				tunerBaseNoteName[1] = "C#";
-				tunerBaseNoteName[2] = "D";
-				tunerBaseNoteName[3] = "D#";
-				tunerBaseNoteName[4] = "E";
-				tunerBaseNoteName[5] = "F";
-				tunerBaseNoteName[6] = "F#";
-				tunerBaseNoteName[7] = "G";
-				tunerBaseNoteName[8] = "G#";
-				tunerBaseNoteName[9] = "A";
-				tunerBaseNoteName[10] = "A#";
-				tunerBaseNoteName[11] = "B";
-			}
-			else {
-				// Flats.
-				tunerBaseNoteName[0] = "C";
-				tunerBaseNoteName[1] = "Db";
-				tunerBaseNoteName[2] = "D";
-				tunerBaseNoteName[3] = "Eb";
-				tunerBaseNoteName[4] = "E";
-				tunerBaseNoteName[5] = "F";
-				tunerBaseNoteName[6] = "Gb";
-				tunerBaseNoteName[7] = "G";
-				tunerBaseNoteName[8] = "Ab";
-				tunerBaseNoteName[9] = "A";
-				tunerBaseNoteName[10] = "Bb";
-				tunerBaseNoteName[11] = "B";
-			}
-		}
-		else {
-			// Do-Re-Mi (French/Italian) notation.
-			tb_OptionID[METRIKS_CVTUNER][2] = "La4 Pitch";
-			if (currentParameter[METRIKS_CVTUNER][1] == 0) {
-				// Sharps.
-				tunerBaseNoteName[0] = "Do";
-				tunerBaseNoteName[1] = "Do#";
-				tunerBaseNoteName[2] = "Re";
-				tunerBaseNoteName[3] = "Re#";
-				tunerBaseNoteName[4] = "Mi";
-				tunerBaseNoteName[5] = "Fa";
-				tunerBaseNoteName[6] = "Fa#";
-				tunerBaseNoteName[7] = "Sol";
-				tunerBaseNoteName[8] = "Sol#";
-				tunerBaseNoteName[9] = "La";
-				tunerBaseNoteName[10] = "La#";
-				tunerBaseNoteName[11] = "Si";
-			}
-			else {
-				// Flats.
-				tunerBaseNoteName[0] = "Do";
-				tunerBaseNoteName[1] = "Reb";
-				tunerBaseNoteName[2] = "Re";
-				tunerBaseNoteName[3] = "Mib";
-				tunerBaseNoteName[4] = "Mi";
-				tunerBaseNoteName[5] = "Fa";
-				tunerBaseNoteName[6] = "Solb";
-				tunerBaseNoteName[7] = "Sol";
-				tunerBaseNoteName[8] = "Lab";
-				tunerBaseNoteName[9] = "La";
-				tunerBaseNoteName[10] = "Sib";
-				tunerBaseNoteName[11] = "Si";
-			}
-		}
-		// Final table construction, including octave.
-		for (int i = 0; i < 132; i++)
-			tunerNote[i] = tunerBaseNoteName[i % 12] + std::to_string((i / 12) - 1);
-	}
-
-	// This method prepares (precompute) frequencies tables, used by CV Tuner mode.
-	void setTunerFreqTables() {
-		for (int i = 0; i < 132; i++) {
-			// Central frequencies (frequency of each note).
-			tb_FreqNote_Center[i] = 440.0 * (double)(pow(2, ((i - 69.0) / 12)));
-			// Low precision ranges tables, also used for initial note detection.
-			tb_FreqNote_LP_LimL[i] = 440.0 * (double)(pow(2, ((i - 69.5) / 12)));
-			tb_FreqNote_LP_LimH[i] = 440.0 * (double)(pow(2, ((i - 68.5) / 12)));
-			// Medium precision ranges tables.
-			tb_FreqNote_MP_LimL[i] = 440.0 * (double)(pow(2, ((i - 69.2) / 12)));
-			tb_FreqNote_MP_LimH[i] = 440.0 * (double)(pow(2, ((i - 68.8) / 12)));
-			// High precision ranges tables.
-			tb_FreqNote_HP_LimL[i] = 440.0 * (double)(pow(2, ((i - 69.02) / 12)));
-			tb_FreqNote_HP_LimH[i] = 440.0 * (double)(pow(2, ((i - 68.98) / 12)));
-		}
+		int notation = (currentParameter[METRIKS_CVTUNER][0] == 0) ? 0 : 1;
+		int flats = (currentParameter[METRIKS_CVTUNER][1] == 0) ? 0 : 1;
+		tunerNote = metriksNotesTables().notes[notation][flats];
 	}
 
 	// Custom method to prepare threshold voltage for display (2nd line).
@@ -594,63 +1387,151 @@ struct MetriksModule : Module {
 		snprintf(dmdTextMain2, sizeof(dmdTextMain2), "%2.1fV", f_pcntTresholdVoltage);
 	}
 
-	// This function will search accurate note, from given frequency, from precomputed tables (best for CPU save, tables are computed on Ref. A4/La4 tuning change only).
-	int getNotebyFreq(double freq) {
+	// Custom method to prepare measured frequency for display (2nd line), right-aligned, upto 8 characters.
+	void setDisplayFrequency(float frequency) {
+		if (frequency < 10000.0f)
+			snprintf(dmdTextMain2, sizeof(dmdTextMain2), "%.3f", frequency);
+			else if (frequency < 100000.0f)
+				snprintf(dmdTextMain2, sizeof(dmdTextMain2), "%.2f", frequency);
+				else snprintf(dmdTextMain2, sizeof(dmdTextMain2), "%.1f", frequency);
+		dmdOffsetTextMain2 = 102.0f - (strlen(dmdTextMain2) * 12.0f);
+	}
+
+	// Custom method to prepare measured tempo for display (2nd line), right-aligned, 0.01 BPM resolution ("--" while no clock).
+	void setDisplayBPM(float bpm) {
+		if (bpm > 0.0f)
+			snprintf(dmdTextMain2, sizeof(dmdTextMain2), "%.2f", bpm);
+			else strcpy(dmdTextMain2, "--");
+		dmdOffsetTextMain2 = 102.0f - (strlen(dmdTextMain2) * 12.0f);
+	}
+
+	// Custom method to reset voltmeter statistics (minimum, maximum, median and percentiles) from given voltage.
+	void resetVoltmeterStats(float voltage) {
+		f_VoltageMin = voltage;
+		f_VoltageMax = voltage;
+		vltmMedian.reset();
+		vltmP5.reset();
+		vltmP95.reset();
+		vltmMedian.process(voltage);
+		vltmP5.process(voltage);
+		vltmP95.process(voltage);
+		levelMeter.restart();
+	}
+
+	// Custom method to prepare Poly Meter for display: channel and statistic on first line, voltage on second line (right-aligned).
+	void setDisplayPolyMeter() {
+		static const char *polyStatistics[3] = {"Min.", "Max.", "RMS"};
+		int statistic = clamp(currentParameter[METRIKS_POLYMETER][0], 0, 2);
+		if (currentParameter[METRIKS_POLYMETER][1] >= 16) {
+			// Scan: next channel every second (about 60 display refreshes).
+			if (++polyScanFrames >= 60) {
+				polyScanFrames = 0;
+				polyChannel++;
+			}
+			if (polyChannel >= polyStats.channels)
+				polyChannel = 0;
+		}
+		else polyChannel = clamp(currentParameter[METRIKS_POLYMETER][1], 0, 15);
+		snprintf(dmdTextMain1, sizeof(dmdTextMain1), "Ch.%i/%i %s", polyChannel + 1, polyStats.channels, polyStatistics[statistic]);
+		if (polyChannel < polyStats.channels)
+			metriksFormatVoltage(polyStats.value(statistic, polyChannel), 3, dmdTextMain2, sizeof(dmdTextMain2), dmdOffsetTextMain2);
+			else {
+				// Selected channel isn't carried by input cable.
+				strcpy(dmdTextMain2, "--");
+				dmdOffsetTextMain2 = 102.0f - (strlen(dmdTextMain2) * 12.0f);
+			}
+	}
+
+	// Custom method to reset Peak Counter (counter and rate).
+	void resetPeakCounter() {
+		pcntCount = 0;
+		bPcntArmed = false;
+		pcntRate = 0.0f;
+		pcntWindowCount = 0;
+		pcntWindowSamples = 0;
+	}
+
+	// Custom method to prepare Peak Counter for display: rate on first line, counter on second line (right-aligned, upto 8 digits,
+	// otherwise using scientific notation).
+	void setDisplayPeakCounter() {
+		if (pcntRate < 1000.0f)
+			snprintf(dmdTextMain1, sizeof(dmdTextMain1), "Peak %.1f/s", pcntRate);
+			else snprintf(dmdTextMain1, sizeof(dmdTextMain1), "Peak %.0f/s", pcntRate);
+		if (pcntCount <= 99999999)
+			snprintf(dmdTextMain2, sizeof(dmdTextMain2), "%llu", (unsigned long long)(pcntCount));
+			else snprintf(dmdTextMain2, sizeof(dmdTextMain2), "%.2e", (double)(pcntCount));
+		dmdOffsetTextMain2 = 102.0f - (strlen(dmdTextMain2) * 12.0f);
+	}
+
+	// Custom method to prepare detected pitch for display (CV Tuner, audio input): frequency on first line, note on second line, with
+	// same markers as V/oct voltage (frequency is converted to V/oct, 0V is C4). "--" while no pitch is detected.
+	void setDisplayAudioPitch(float frequency) {
+		if (frequency > 0.0f) {
+			snprintf(dmdTextMain1, sizeof(dmdTextMain1), "Tuner %.1fHz", frequency);
+			int x = getNotebyVoltage(std::log2(frequency / dsp::FREQ_C4));
+			if (x != -1)
+				_tmpString = tunerNote[x];
+				else _tmpString = "?";
+		}
+		else {
+			strcpy(dmdTextMain1, "Audio Tuner");
+			b_tunrMarkerVisible = false;
+			_tmpString = "--";
+		}
+		dmdOffsetTextMain2 = getCenteredDMD(_tmpString); // Centered display on second line.
+		strcpy(dmdTextMain2, _tmpString.c_str());
+	}
+
+	// This function returns the note (index in notes table), directly computed from given V/oct voltage (0V is C4): nearest semitone,
+	// then its offset in cents (no frequency conversion, no table scan). Precision bands are expressed in cents: high precision is
+	// below 2 cents, medium precision below 20 cents, otherwise low precision (upto 50 cents).
+	int getNotebyVoltage(float voltage) {
 		int aPos = -1;
-		int startPos = 0;
-		bool b_IsAbove = false;
-		if (freq > 369.0f)
-			startPos = 66; // Start the table scans from... middle (F#4 / Gb4).
-		if ((freq >= tb_FreqNote_LP_LimL[0]) && (freq < tb_FreqNote_LP_LimH[131])) {
-			// Doing search only if input frequency is in allowed limits (C-1 to B9).
-			for (int i = startPos; i < 132; i++) {
-				// Finding note (from LP - low-precision - tables).
-				if ((freq >= tb_FreqNote_LP_LimL[i]) && (freq < tb_FreqNote_LP_LimH[i])) {
-					// Note is found.
-					aPos = i;
-					b_IsAbove = (freq >= tb_FreqNote_Center[aPos]); // true if the frequency is above "center" frequency/note...
-					if ((freq >= tb_FreqNote_HP_LimL[aPos]) && (freq < tb_FreqNote_HP_LimH[aPos])) {
- 						// High precision: don't display left/right marker(s).
-						b_tunrMarkerVisible = false;
-						dmdTunerMarkerPos = 0.0f;
-						strcpy(dmdTunerMarker, " ");
-					}
-					else if ((freq >= tb_FreqNote_MP_LimL[aPos]) && (freq < tb_FreqNote_MP_LimH[aPos])) {
- 						// Medium precision: display one marker only, either "<" or ">".
-						b_tunrMarkerVisible = true;
-						if (b_IsAbove) {
-							dmdTunerMarkerPos = 2.6f;
-							strcpy(dmdTunerMarker, "<");
-						}
-						else {
-							dmdTunerMarkerPos = 90.0f;
-							strcpy(dmdTunerMarker, ">");
-						}
-					}
-					else {
- 						// Near bounds (aka bad precision): display three markers, either "<<<" or ">>>", because frequency is near bound.
-						b_tunrMarkerVisible = true;
-						if (b_IsAbove) {
-							dmdTunerMarkerPos = 2.6f;
-							strcpy(dmdTunerMarker, "<<");
-						}
-						else {
-							dmdTunerMarkerPos = 84.0f;
-							strcpy(dmdTunerMarker, ">>");
-						}
-					}
-					i = 132; // Exit note scan loop.
+		double semitones = 60.0 + 12.0 * (double)(voltage);
+		if ((semitones >= -0.5) && (semitones < 131.5)) {
+			// Note is allowed (C-1 to B9).
+			aPos = (int)(std::floor(semitones + 0.5));
+			double cents = 100.0 * (semitones - (double)(aPos));
+			bool b_IsAbove = (cents >= 0.0); // true if the voltage is above "center" voltage/note...
+			if (std::fabs(cents) < 2.0) {
+				// High precision: don't display left/right marker(s).
+				b_tunrMarkerVisible = false;
+				dmdTunerMarkerPos = 0.0f;
+				strcpy(dmdTunerMarker, " ");
+			}
+			else if (std::fabs(cents) < 20.0) {
+				// Medium precision: display one marker only, either "<" or ">".
+				b_tunrMarkerVisible = true;
+				if (b_IsAbove) {
+					dmdTunerMarkerPos = 2.6f;
+					strcpy(dmdTunerMarker, "<");
+				}
+				else {
+					dmdTunerMarkerPos = 90.0f;
+					strcpy(dmdTunerMarker, ">");
+				}
+			}
+			else {
+				// Near bounds (aka bad precision): display three markers, either "<<<" or ">>>", because voltage is near bound.
+				b_tunrMarkerVisible = true;
+				if (b_IsAbove) {
+					dmdTunerMarkerPos = 2.6f;
+					strcpy(dmdTunerMarker, "<<");
+				}
+				else {
+					dmdTunerMarkerPos = 84.0f;
+					strcpy(dmdTunerMarker, ">>");
 				}
 			}
 		}
-		else if (freq < tb_FreqNote_LP_LimL[0]) {
-			// Input frequency is too low (below C-1).
+		else if (semitones < -0.5) {
+			// Input voltage is too low (below C-1).
 			b_tunrMarkerVisible = true;
 			dmdTunerMarkerPos = 84.0f;
 			strcpy(dmdTunerMarker, ">>");
 		}
 		else {
-			// Input frequency is too high (above B9).
+			// Input voltage is too high (above B9).
 			b_tunrMarkerVisible = true;
 			dmdTunerMarkerPos = 2.6f;
 			strcpy(dmdTunerMarker, "<<");
@@ -704,48 +1585,6 @@ struct MetriksModule : Module {
 		return ((105.8f - (11.3f * (float)(px) / 6.0f)) / 2.0f) - 7.0f;
 	}
 
-	// TEMPORARY - used for inoperative mode(s) - MUST BE REMOVED WHEN ALL MODES WORK.
-	void setInopMode() {
-		if (b_InopMode)
-			return;
-		b_InopMode = true;
-		ct_InopModeTimer = (int)(1.5f * sampleRate); // This timer is used to cycle inop. messages every 1.5 second.
-		i_InopMsgCycling = 0; // Index to displayed message.
-	}
-
-	// TEMPORARY - used for inoperative mode(s) - MUST BE REMOVED WHEN ALL MODES WORK.
-	void runInopMode() {
-		if (ct_InopModeTimer > 0)
-			ct_InopModeTimer--;
-			else {
-				ct_InopModeTimer = (int)(1.5f * sampleRate); // This timer is used to cycle inop. messages every 1.5 second.
-				i_InopMsgCycling++; // Point to next message to display (or restart if necessary).
-				if (i_InopMsgCycling > 5)
-					i_InopMsgCycling = 0;
-			}
-		// Display inoperative message...
-		dmdOffsetTextMain2 = 1.0f;
-		switch (i_InopMsgCycling) {
-			case 0:
-				strcpy(dmdTextMain2, "This mode");
-				break;
-			case 1:
-				strcpy(dmdTextMain2, "can't be");
-				break;
-			case 2:
-				strcpy(dmdTextMain2, "used yet.");
-				break;
-			case 3:
-				strcpy(dmdTextMain2, "Still in");
-				break;
-			case 4:
-				strcpy(dmdTextMain2, "developm!");
-				break;
-			case 5:
-				strcpy(dmdTextMain2, "");
-		}
-	}
-
 	// Module's DSP.
 	void process(const ProcessArgs &args) override {
 		// DSP processing...
@@ -762,18 +1601,37 @@ struct MetriksModule : Module {
 			b_dspIsRunning = true; // Yes, DSP is running...
 		}
 
-		// TEMPORARY - used for inoperative mode(s) - MUST BE REMOVED WHEN ALL MODES WORK.
-		if (b_InopMode)
-			if (!bChangingMode && !bChangingOption)
-				runInopMode();
+		// Frequency Counter: measure is restarted if it wasn't running at previous step (other mode, changing mode/option, no input).
+		bool bFcntWasRunning = bFcntRunning;
+		bFcntRunning = false;
+		// Same for BPM Meter.
+		bool bBpmWasRunning = bBpmRunning;
+		bBpmRunning = false;
+		// Same for Voltmeter level metering.
+		bool bLevelWasRunning = bLevelRunning;
+		bLevelRunning = false;
+		// Same for Voltmeter statistics (median, percentiles).
+		bool bVltmStatsWasRunning = bVltmStatsRunning;
+		bVltmStatsRunning = false;
+		// Same for Poly Meter.
+		bool bPolyWasRunning = bPolyRunning;
+		bPolyRunning = false;
 
 		// Is IN (INput) jack connected?
 		bActiveINjack = inputs[INPUT_SOURCE].isConnected();
 
-		// Transmit (as passthrough/daisy chain) current voltage on IN jack, to OUT jack. 0V will be sent as long as IN jack remains disconnected!
-		if (bActiveINjack)
-			outputs[OUTPUT_THRU].setVoltage(inputs[INPUT_SOURCE].getVoltage());
-			else outputs[OUTPUT_THRU].setVoltage(0.0f);
+		// Voltmeter snapshot is active while voltmeter is measuring (state of previous step, for mode and option).
+		bVltmSnapshot.store((Mode == METRIKS_VOLTMETER) && bActiveINjack && !bChangingMode && !bChangingOption);
+
+		// Transmit (as passthrough/daisy chain) all channels on IN jack, to OUT jack (polyphonic). 0V will be sent as long as IN jack remains disconnected!
+		if (bActiveINjack) {
+			outputs[OUTPUT_THRU].setChannels(inputs[INPUT_SOURCE].getChannels());
+			outputs[OUTPUT_THRU].writeVoltages(inputs[INPUT_SOURCE].getVoltages());
+		}
+		else {
+			outputs[OUTPUT_THRU].setChannels(1);
+			outputs[OUTPUT_THRU].setVoltage(0.0f);
+		}
 
 		// Read if the continuous encoder is moved...
 		encoderParam = (int)roundf(10.0f * params[PARAM_ENCODER].getValue());
@@ -784,7 +1642,7 @@ struct MetriksModule : Module {
 					if (!bChangingOption) {
 						// Can change current mode.
 						Mode++;
-						if (Mode > 4)
+						if (Mode > METRIKS_NUM_MODES - 1)
 							Mode = 0; // Returning to first mode (aka "Voltmeter").
 						_Mode = Mode; // Done by encoder: backup to old/previous state variable.
 						ct_SwitchedMode = (int)(1.0f * sampleRate);
@@ -821,7 +1679,7 @@ struct MetriksModule : Module {
 						// Can change current mode.
 						Mode--;
 						if (Mode < 0)
-							Mode = 4; // Returning to last mode (aka "Peak Counter").
+							Mode = METRIKS_NUM_MODES - 1; // Returning to last mode (aka "Poly Meter").
 						_Mode = Mode; // Done by encoder: backup to old/previous state variable.
 						ct_SwitchedMode = (int)(1.0f * sampleRate);
 						bChangingMode = true;
@@ -892,6 +1750,11 @@ struct MetriksModule : Module {
 						dmdOffsetTextMain2 = 3.52f; // Centered "Peak Cnt." message on second line of DMD.
 						strcpy(dmdTextMain2, "Peak Cnt.");
 						break;
+					case 5:
+						// Poly meter.
+						dmdOffsetTextMain2 = -2.125f; // Centered "Poly Meter" message on second line of DMD.
+						strcpy(dmdTextMain2, "Poly Meter");
+						break;
 				}
 				return; // while changing mode, do nothing else!
 			}
@@ -899,7 +1762,6 @@ struct MetriksModule : Module {
 				// Exit point for changing mode.
 				b_tunrMarkerVisible = false; // To avoid "marker(s)" displayed on DMD!
 				_f_InVoltage = f_InVoltage + 1.0f; // By doing this, the second line of DMD will be refreshed.
-				b_InopMode = false; // TEMPORARY - false means the mode is operational (totally or partially) - MUST BE REMOVED WHEN ALL MODES WORK.
 				bChangingMode = false;
 			}
 		}
@@ -916,7 +1778,6 @@ struct MetriksModule : Module {
 						currentOptionID = 0;
 						lights[LED_OPTIONS].setBrightness(0.0f);
 						bChangingOption = false; // Exit options.
-						b_InopMode = false; // TEMPORARY - false means the mode is operational (totally or partially) - MUST BE REMOVED WHEN ALL MODES WORK.
 						_f_InVoltage = f_InVoltage + 1.0f; // By doing this, the second line of DMD will be refreshed.
 					}
 					else {
@@ -931,7 +1792,6 @@ struct MetriksModule : Module {
 						currentOptionID = 0;
 						ct_OptionBlinkTimer = (int)(sampleRate); // For LED blink.
 						bChangingOption = true;
-						b_InopMode = false; // TEMPORARY - false means the mode is operational (totally or partially) - MUST BE REMOVED WHEN ALL MODES WORK.
 						lights[LED_OPTIONS].setBrightness(1.0f);
 						_tmpString = tb_OptionID[Mode][0];
 						strcpy(dmdTextMain1, _tmpString.c_str());
@@ -953,21 +1813,25 @@ struct MetriksModule : Module {
 		}
 
 		// RESET button and/or input jack:
-		// - Voltmeter mode: reset Min, Max and Med voltages.
+		// - Voltmeter mode: reset Min, Max, Med and percentiles voltages (also restarts level metering window).
 		// - Peak Counter: reset the counter. 
+		// - Poly Meter: reset statistics of all channels.
 		if (resetButton.process(params[BUTTON_RESET].getValue()) || resetPort.process(rescale(inputs[INPUT_RESET].getVoltage(), 0.2f, 1.7f, 0.0f, 1.0f))) {
 			resetButton.reset();
 			switch (Mode) {
 				case METRIKS_VOLTMETER:
-					// Reset Min, Max and median registered voltages.
-					f_VoltageMin = f_InVoltage;
-					f_VoltageMax = f_InVoltage;
-					f_VoltageMed = f_InVoltage;
+					// Reset Min, Max, median and percentiles registered voltages.
+					resetVoltmeterStats(f_InVoltage);
 					_f_InVoltage = f_InVoltage + 1.0f; // By doing this, the second line of DMD will be refreshed.
-//					break;
-//				case METRIKS_PEAKCOUNTER:
-					// ToDo...
-//					break;
+					break;
+				case METRIKS_PEAKCOUNTER:
+					// Reset the counter (and its rate).
+					resetPeakCounter();
+					break;
+				case METRIKS_POLYMETER:
+					// Reset statistics of all channels.
+					polyStats.restart();
+					break;
 			}
 		}
 
@@ -1010,7 +1874,6 @@ struct MetriksModule : Module {
 				currentOptionID = 0;
 				ct_OptionBlinkTimer = 0;
 				bChangingOption = false;
-				b_InopMode = false; // TEMPORARY - false means the mode is operational (totally or partially) - MUST BE REMOVED WHEN ALL MODES WORK.
 			}
 			return;
 		}
@@ -1018,36 +1881,32 @@ struct MetriksModule : Module {
 		// Display current mode on first line of DMD (if not currently changing an option for current mode).
 			switch (Mode) {
 				case 0:
-					// Voltmeter mode.
-					switch (currentParameter[METRIKS_VOLTMETER][0]) {
-						case 0:
-							// Voltmeter, realtime (default metering option).
-							strcpy(dmdTextMain1, "Voltmeter");
-							break;
-						case 1:
-							// Voltmeter, minimum.
-							strcpy(dmdTextMain1, "Voltm. Min.");
-							break;
-						case 2:
-							// Voltmeter, maximum.
-							strcpy(dmdTextMain1, "Voltm. Max.");
-							break;
-						case 3:
-							// Voltmeter, median.
-							strcpy(dmdTextMain1, "Voltm. Medn.");
-					}
+					// Voltmeter mode: while input is connected, both lines are formatted by DMD (from snapshot).
+					if (!bActiveINjack)
+						strcpy(dmdTextMain1, metriksVoltmeterTitles[clamp(currentParameter[METRIKS_VOLTMETER][0], 0, METRIKS_VLTM_METERINGS - 1)]);
 					break;
 				case 1:
-					strcpy(dmdTextMain1, "CV Tuner");
+					// CV Tuner: with audio input (while input is connected), first line shows the frequency (set at UI rate).
+					if (currentParameter[METRIKS_CVTUNER][2] != 1)
+						strcpy(dmdTextMain1, "CV Tuner");
+						else if (!bActiveINjack)
+							strcpy(dmdTextMain1, "Audio Tuner");
 					break;
 				case 2:
-					strcpy(dmdTextMain1, "Freq. Counter");
+					strcpy(dmdTextMain1, "Freq. Cnt. Hz");
 					break;
 				case 3:
 					strcpy(dmdTextMain1, "BPM Meter");
 					break;
 				case 4:
-					strcpy(dmdTextMain1, "Peak Counter");
+					// Peak Counter: while input is connected, first line shows the rate (set at UI rate).
+					if (!bActiveINjack)
+						strcpy(dmdTextMain1, "Peak Counter");
+					break;
+				case 5:
+					// Poly Meter: while input is connected, first line shows channel and statistic (set at UI rate).
+					if (!bActiveINjack)
+						strcpy(dmdTextMain1, "Poly Meter");
 			}
 		}
 
@@ -1064,7 +1923,6 @@ struct MetriksModule : Module {
 				f_VoltageMax = f_InVoltage;
 				else if (f_InVoltage < f_VoltageMin)
 					f_VoltageMin = f_InVoltage;
-			f_VoltageMed = (f_VoltageMax + f_VoltageMin) / 2.0f;
 			ct_NoInputTimer = 0;
 		}
 		else {
@@ -1073,7 +1931,9 @@ struct MetriksModule : Module {
 			_f_InVoltage = 1.0f;
 			f_VoltageMin = 99999.0f;
 			f_VoltageMax = -99999.0f;
-			f_VoltageMed = 0.0f;
+			vltmMedian.reset();
+			vltmP5.reset();
+			vltmP95.reset();
 			// Be sure Peak Counter is stopped. Unlit PLAY/PAUSE bi-colored LED.
 			lights[LED_PLAY_GREEN].setBrightness(0.0f);
 			lights[LED_PLAY_RED].setBrightness(0.0f);
@@ -1093,90 +1953,98 @@ struct MetriksModule : Module {
 			switch (Mode) {
 				case METRIKS_VOLTMETER:
 					// Voltmeter mode implementation.
-					b_InopMode = false; // TEMPORARY - false means the mode is operational (totally or partially) - MUST BE REMOVED WHEN ALL MODES WORK.
 					b_tunrMarkerVisible = false; // To avoid "marker(s)" displayed on DMD!
 					// Be sure Peak Counter is stopped. Unlit PLAY/PAUSE bi-colored LED.
 					lights[LED_PLAY_GREEN].setBrightness(0.0f);
 					lights[LED_PLAY_RED].setBrightness(0.0f);
 					bPeakCounterIsPlaying = false;
-					if (f_InVoltage != _f_InVoltage) {
-						// Display voltage, but if it was changed only! Also, if number of decimal(s) option was changed.
-						float vFloor;
-						float vCeiling;
-						std::string vSign = "+";
-						std::string vMask = "";
-						float currentVoltage = 0.0f;
-						_f_InVoltage = f_InVoltage;
-						switch (currentParameter[METRIKS_VOLTMETER][0]) {
-							case 0:
-								// Voltmeter, realtime (default metering option).
-								currentVoltage = roundp((double)f_InVoltage, vltmDecimals);
-								break;
-							case 1:
-								// Voltmeter, minimum.
-								currentVoltage = roundp((double)f_VoltageMin, vltmDecimals);
-								break;
-							case 2:
-								// Voltmeter, maximum.
-								currentVoltage = roundp((double)f_VoltageMax, vltmDecimals);
-								break;
-							case 3:
-								// Voltmeter, median.
-								currentVoltage = roundp((double)f_VoltageMed, vltmDecimals);
-						}
-						if (currentVoltage < 0.0f)
-							vSign = "-";
-						currentVoltage = abs(currentVoltage);
-						switch (vltmDecimals) {
-							case 0:
-								vFloor = -99999.0f;
-								vCeiling = 99999.0f;
-								break;
-							case 1:
-								vFloor = -9999.99f;
-								vCeiling = 9999.99f;
-								break;
-							case 2:
-								vFloor = -999.999f;
-								vCeiling = 999.999f;
-								break;
-							case 3:
-								vFloor = -99.9999f;
-								vCeiling = 99.9999f;
-								break;
-						}
-						if ((currentVoltage >= vFloor) && (currentVoltage <= vCeiling)) {
-							_tmpString = std::to_string(currentVoltage);
-							int vPos = _tmpString.find(".");
-							if (vltmDecimals == 0)
-								vPos--;
-							_tmpString = _tmpString.substr (0, vPos + vltmDecimals + 1);
-							_tmpString = vSign + _tmpString + "V";
-							if (vltmDecimals == 0)
-								dmdOffsetTextMain2 = 96.0f - (_tmpString.length() * 12.0f);
-								else dmdOffsetTextMain2 = 102.0f - (_tmpString.length() * 12.0f);
-							strcpy(dmdTextMain2, _tmpString.c_str());
-						}
-						else {
-							// Voltage is out of range (overflow).
-							dmdOffsetTextMain2 = 2.583f;
-							strcpy(dmdTextMain2, "!Out.Rang.!");
+					// Streaming median and percentiles (all statistics are restarted when voltmeter mode is entered again).
+					if (!bVltmStatsWasRunning)
+						resetVoltmeterStats(f_InVoltage);
+					else {
+						vltmMedian.process(f_InVoltage);
+						vltmP5.process(f_InVoltage);
+						vltmP95.process(f_InVoltage);
+					}
+					bVltmStatsRunning = true;
+					// Level metering is computed only while selected.
+					if (currentParameter[METRIKS_VOLTMETER][0] >= METRIKS_VLTM_LEVEL) {
+						// Buffers (sized to selected window) are requested, then used as soon as UI thread has allocated them.
+						levelWindowRequest.store(levelMeter.windowLength, std::memory_order_relaxed);
+						int active = levelBuffersActive.load();
+						if (active != levelBuffersInUse.load(std::memory_order_relaxed)) {
+							levelBuffersInUse.store(active);
+							levelMeter.setBuffers(&levelBuffers[active]);
 						}
-						// Restore backuped voltage...
-						f_InVoltage = _f_InVoltage;
+						if (!bLevelWasRunning)
+							levelMeter.restart();
+						bLevelRunning = true;
+						levelMeter.process(f_InVoltage);
+					}
+					// Publishing reading (formatted by DMD at frame rate).
+					switch (currentParameter[METRIKS_VOLTMETER][0]) {
+						case 1:
+							// Voltmeter, minimum.
+							vltmSnapshotVoltage.store(f_VoltageMin);
+							break;
+						case 2:
+							// Voltmeter, maximum.
+							vltmSnapshotVoltage.store(f_VoltageMax);
+							break;
+						case 3:
+							// Voltmeter, median.
+							vltmSnapshotVoltage.store(vltmMedian.value());
+							break;
+						case 4:
+							// Voltmeter, 5th percentile.
+							vltmSnapshotVoltage.store(vltmP5.value());
+							break;
+						case 5:
+							// Voltmeter, 95th percentile.
+							vltmSnapshotVoltage.store(vltmP95.value());
+							break;
+						case 6:
+						case 7:
+						case 8:
+						case 9:
+							// Voltmeter, RMS, mean, crest factor or true-peak.
+							vltmSnapshotVoltage.store(levelMeter.value());
+							break;
+						default:
+							// Voltmeter, realtime (default metering option).
+							vltmSnapshotVoltage.store(f_InVoltage);
 					}
+					vltmSnapshotMetering.store(clamp(currentParameter[METRIKS_VOLTMETER][0], 0, METRIKS_VLTM_METERINGS - 1));
+					vltmSnapshotDecimals.store(vltmDecimals);
 					break;
 				case METRIKS_CVTUNER:
 					// CV Tuner mode implementation.
-					b_InopMode = false; // TEMPORARY - false means the mode is operational (totally or partially) - MUST BE REMOVED WHEN ALL MODES WORK.
 					// Be sure Peak Counter is stopped. Unlit PLAY/PAUSE bi-colored LED.
 					lights[LED_PLAY_GREEN].setBrightness(0.0f);
 					lights[LED_PLAY_RED].setBrightness(0.0f);
 					bPeakCounterIsPlaying = false;
-					if (f_InVoltage != _f_InVoltage) {
+					if (currentParameter[METRIKS_CVTUNER][2] == 1) {
+						// Audio input: single write into ring buffer (pitch is detected by background worker). Ring (sized for current
+						// sample rate) is requested, then used as soon as UI thread has allocated it (write is skipped until then).
+						pitchRingRequest.store(pitchRingLength, std::memory_order_relaxed);
+						int active = pitchRingActive.load();
+						if (active != pitchRingInUse.load(std::memory_order_relaxed)) {
+							pitchRing = pitchRings[active].get();
+							pitchRingInUse.store(active);
+						}
+						if (pitchRing != nullptr) {
+							uint32_t writeIndex = pitchWriteIndex.load(std::memory_order_relaxed);
+							pitchRing->samples[writeIndex & (pitchRing->length - 1)].store(f_InVoltage, std::memory_order_relaxed);
+							pitchWriteIndex.store(writeIndex + 1, std::memory_order_release);
+						}
+						// Display is refreshed at UI rate only.
+						if (displayDivider.process())
+							setDisplayAudioPitch(pitchFrequency.load());
+					}
+					else if (f_InVoltage != _f_InVoltage) {
 						// Doing note search by voltage (CV), but only if voltage has changed!
 						_f_InVoltage = f_InVoltage;
-						int x = getNotebyFreq(dsp::FREQ_C4 * (double)(pow(2.0, f_InVoltage)));
+						int x = getNotebyVoltage(f_InVoltage);
 						if (x != -1)
 							_tmpString = tunerNote[x];
 							else _tmpString = "?";
@@ -1191,8 +2059,13 @@ struct MetriksModule : Module {
 					lights[LED_PLAY_GREEN].setBrightness(0.0f);
 					lights[LED_PLAY_RED].setBrightness(0.0f);
 					bPeakCounterIsPlaying = false;
-					// TEMPORARY - used for inoperative mode(s) - MUST BE REMOVED WHEN ALL MODES WORK.
-					setInopMode();
+					if (!bFcntWasRunning)
+						frequencyCounter.restart();
+					bFcntRunning = true;
+					frequencyCounter.process(f_InVoltage);
+					// Display is refreshed at UI rate only.
+					if (displayDivider.process())
+						setDisplayFrequency(frequencyCounter.frequency);
 					break;
 				case METRIKS_BPMMETER:
 					// BPM meter mode implementation.
@@ -1201,14 +2074,63 @@ struct MetriksModule : Module {
 					lights[LED_PLAY_GREEN].setBrightness(0.0f);
 					lights[LED_PLAY_RED].setBrightness(0.0f);
 					bPeakCounterIsPlaying = false;
-					// TEMPORARY - used for inoperative mode(s) - MUST BE REMOVED WHEN ALL MODES WORK.
-					setInopMode();
+					if (!bBpmWasRunning) {
+						bpmMeter.restart();
+						inputPort.reset();
+					}
+					bBpmRunning = true;
+					bpmMeter.process(inputPort.process(rescale(f_InVoltage, 0.2f, 1.7f, 0.0f, 1.0f)));
+					// Display is refreshed at UI rate only.
+					if (displayDivider.process())
+						setDisplayBPM(bpmMeter.bpm);
 					break;
 				case METRIKS_PEAKCOUNTER:
 					// Peak counter mode implementation.
 					b_tunrMarkerVisible = false; // To avoid "marker(s)" displayed on DMD!
-					// TEMPORARY - used for inoperative mode(s) - MUST BE REMOVED WHEN ALL MODES WORK.
-					setInopMode();
+					// PLAY/PAUSE button and/or input jack: start or pause counting.
+					if (playButton.process(params[BUTTON_PLAYPAUSE].getValue()) || playPort.process(rescale(inputs[INPUT_PLAYPAUSE].getVoltage(), 0.2f, 1.7f, 0.0f, 1.0f))) {
+						bPeakCounterIsPlaying = !bPeakCounterIsPlaying;
+						pcntWindowCount = pcntCount;
+						pcntWindowSamples = 0;
+						pcntRate = 0.0f;
+					}
+					// PLAY/PAUSE bi-colored LED: green while counting, red while paused.
+					lights[LED_PLAY_GREEN].setBrightness(bPeakCounterIsPlaying ? 1.0f : 0.0f);
+					lights[LED_PLAY_RED].setBrightness(bPeakCounterIsPlaying ? 0.0f : 1.0f);
+					if (bPeakCounterIsPlaying) {
+						// Peak detection at threshold voltage, with hysteresis.
+						if (f_InVoltage < f_pcntTresholdVoltage - pcntHysteresis)
+							bPcntArmed = true;
+							else if (bPcntArmed && (f_InVoltage >= f_pcntTresholdVoltage)) {
+								bPcntArmed = false;
+								pcntCount++;
+							}
+						// Rate (peaks per second), for each one second window.
+						pcntWindowSamples++;
+						if (pcntWindowSamples >= (int)(sampleRate)) {
+							pcntRate = (float)(pcntCount - pcntWindowCount) * sampleRate / (float)(pcntWindowSamples);
+							pcntWindowCount = pcntCount;
+							pcntWindowSamples = 0;
+						}
+					}
+					// Display is refreshed at UI rate only.
+					if (displayDivider.process())
+						setDisplayPeakCounter();
+					break;
+				case METRIKS_POLYMETER:
+					// Poly Meter mode implementation.
+					b_tunrMarkerVisible = false; // To avoid "marker(s)" displayed on DMD!
+					// Be sure Peak Counter is stopped. Unlit PLAY/PAUSE bi-colored LED.
+					lights[LED_PLAY_GREEN].setBrightness(0.0f);
+					lights[LED_PLAY_RED].setBrightness(0.0f);
+					bPeakCounterIsPlaying = false;
+					if (!bPolyWasRunning)
+						polyStats.restart();
+					bPolyRunning = true;
+					polyStats.process(inputs[INPUT_SOURCE]);
+					// Display is refreshed at UI rate only.
+					if (displayDivider.process())
+						setDisplayPolyMeter();
 					break;
 			}
 		}
@@ -1259,7 +2181,7 @@ struct MetriksModule : Module {
 		json_t *ModeJ = json_object_get(rootJ, "Mode");
 		if (ModeJ) {
 			Mode = json_integer_value(ModeJ);
-			if ((Mode < 0) || (Mode > 4))
+			if ((Mode < 0) || (Mode > METRIKS_NUM_MODES - 1))
 				Mode = 0; // Set mode to Voltmeter if not compliant.
 		}
 		else Mode = 0; // Default voltmeter.
@@ -1275,8 +2197,10 @@ struct MetriksModule : Module {
 			f_VoltageMax = json_real_value(lastVMaxJ);
 		}
 		else f_VoltageMax = -99999.0f;
-		// Now we can define last median voltage (never stored, always computed).
-		f_VoltageMed = (f_VoltageMax + f_VoltageMin) / 2.0f;
+		// Median and percentiles are never stored (streaming estimates are restarted).
+		vltmMedian.reset();
+		vltmP5.reset();
+		vltmP95.reset();
 		// Retrieving all saved options/parameters (per mode) (two-dimension array of integers).
 		json_t *optionsJ = json_object_get(rootJ, "MtrxOptions");
 		if (optionsJ) {
@@ -1349,14 +2273,26 @@ struct MetriksDMD : TransparentWidget {
 				return; // Exit method immediatly (code below will be ignored).
 			}
 			nvgFillColor(args.vg, nvgTransRGBA(tblDMDtextColor[module->Model], 0xff)); // Using current color for DMD.
+			// Lines to display: voltmeter reading is formatted here (from snapshot), otherwise lines are prepared by module.
+			const char *textMain1 = module->dmdTextMain1;
+			const char *textMain2 = module->dmdTextMain2;
+			float offsetTextMain2 = module->dmdOffsetTextMain2;
+			char vltmText[20];
+			if (module->bVltmSnapshot.load()) {
+				textMain1 = metriksVoltmeterTitles[module->vltmSnapshotMetering.load()];
+				if (module->vltmSnapshotMetering.load() == METRIKS_VLTM_LEVEL + MetriksLevelMeter::LEVEL_CREST)
+					metriksFormatRatio(module->vltmSnapshotVoltage.load(), module->vltmSnapshotDecimals.load(), vltmText, sizeof(vltmText), offsetTextMain2);
+					else metriksFormatVoltage(module->vltmSnapshotVoltage.load(), module->vltmSnapshotDecimals.load(), vltmText, sizeof(vltmText), offsetTextMain2);
+				textMain2 = vltmText;
+			}
 			if (!module->isBypassed())
-				nvgText(args.vg, textPos.x, textPos.y, module->dmdTextMain1, NULL); // Proceeding module->dmdTextMain2 string (second line).
+				nvgText(args.vg, textPos.x, textPos.y, textMain1, NULL); // Proceeding first line.
 			// Main DMD, lower line.
 			nvgFontSize(args.vg, 20);
 			nvgTextLetterSpacing(args.vg, -1);
 			textPos = Vec(12, box.size.y - 152);
 			if (!module->isBypassed())
-				nvgText(args.vg, textPos.x + module->dmdOffsetTextMain2, textPos.y, module->dmdTextMain2, NULL); // Displaying module->dmdTextMain2 string (second line). The second line may have an horizontal offset.
+				nvgText(args.vg, textPos.x + offsetTextMain2, textPos.y, textMain2, NULL); // Displaying second line. The second line may have an horizontal offset.
 			// CV Tuner (Mode = 1) only from this point.
 			if (module->Mode != 1)
 				return; // Exit immediatly (code below will be ignored) if current mode isn't "CV Tuner".
@@ -1601,6 +2537,10 @@ struct MetriksWidget : ModuleWidget {
 	void step() override {
 		MetriksModule *module = dynamic_cast<MetriksModule*>(this->module);
 		if (module) {
+			// Allocating level metering buffers (Voltmeter), if required.
+			module->allocateLevelBuffers();
+			// Requesting pitch detection (CV Tuner, audio input), if new samples are available.
+			module->requestPitchAnalysis();
 			// Possible panels.
 			panelMetriksCreamy->visible = (module->Model == 0);
 			panelMetriksStageRepro->visible = (module->Model == 1);
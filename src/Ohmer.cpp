@@ -11,6 +11,7 @@ void init(rack::Plugin *p) {
 	p->addModel(modelKlokSpid); // KloSpid module.
 	p->addModel(modelRKD); // RKD (Rotate Klok Divider) module.
 	p->addModel(modelBRK); // BRK ("Break") expander module for RKD (Rotate Klok Divider).
+	p->addModel(modelRKX); // RKX (eight extra outputs) expander module for RKD (Rotate Klok Divider).
 	p->addModel(modelMetriks); // Metriks module.
 	p->addModel(modelPolaritySwitch); // Polarity Switch module.
 	p->addModel(modelSplitter); // Splitter 1x9 module.
@@ -8,6 +8,7 @@ extern Plugin *pluginInstance;
 extern Model *modelKlokSpid;
 extern Model *modelRKD;
 extern Model *modelBRK;
+extern Model *modelRKX;
 extern Model *modelMetriks;
 extern Model *modelPolaritySwitch;
 extern Model *modelSplitter;
@@ -19,6 +20,41 @@ extern Model *modelBlankPanel16;
 extern Model *modelBlankPanel32;
 
 
+//// MESSAGE SENT BY BRK EXPANDER TO RKD MODULE.
+
+// Protocol version. Fields are only appended by next versions (RKD accepts any version from 1).
+#define BRK_MESSAGE_VERSION 1
+
+// BRK sends a message only when a switch changes, or when its RKD neighbour changes, using a new generation number.
+// RKD applies a message only once (when generation, or sender, is different from previous applied message).
+struct BRKMessage {
+	// Protocol version (0 means no message was sent yet).
+	int version = 0;
+	// Sender (BRK module id), and generation number (incremented by BRK for every sent message).
+	int64_t senderId = -1;
+	uint32_t generation = 0;
+	// States of six switches (same order than RKD jumpers).
+	bool switches[6] = {};
+	// Table set to select (-1: unchanged), and rotation offset added to ROTATE index (0: none). Not sent by BRK itself (reserved).
+	int tableSet = -1;
+	int rotateOffset = 0;
+};
+
+//// MESSAGE SENT BY RKX EXPANDER TO RKD MODULE.
+
+struct RKXCycleMessage {
+	// Set while CYCLE input jack (RKX) is wired, and its voltage (selects RKD Auto-Reset cycle).
+	bool bCycleCV = false;
+	float cycleCV = 0.0f;
+};
+
+//// MESSAGES RECEIVED BY RKD MODULE (FROM BRK OR RKX EXPANDER, PLACED ALONGSIDE).
+
+struct RKDExpanderMessage {
+	BRKMessage brk;
+	RKXCycleMessage rkx;
+};
+
 //// COLOR TABLE USED FOR DOT-MATRIX DISPLAY (REGARDLING SELECTED MODEL) - KLOKSPID & METRIKS MODULES.
 
 static const NVGcolor tblDMDtextColor[6] = {
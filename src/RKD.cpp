@@ -8,6 +8,109 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Ohmer.hpp"
+#include "RKDEngine.hpp"
+
+// Precomputed rotation rows of built-in tables (declared in RKDEngine.hpp), built once at plugin load.
+const RKDRotationTables rkdRotationTables;
+
+// Engine doesn't depend on Rack headers: its number of channels must match polyphonic ports.
+static_assert(RKD_NUM_CHANNELS == PORT_MAX_CHANNELS, "RKD engine channels must match PORT_MAX_CHANNELS");
+
+// User-defined tables (loaded from "Ohmer/RKD-user-tables.json" file into Rack user folder, or from patch), are using table set
+// indexes from 8 (indexes 6 to 7 are reserved for possible built-in tables).
+#define RKD_FIRST_USER_TABLESET 8
+// Maximum number of user tables, and maximum length (number of dividers) for a user table.
+#define RKD_MAX_USER_TABLES 16
+#define RKD_MAX_USER_TABLE_LENGTH 64
+
+// User tables. Each table is a list of dividers (1 to 64, or -9 to -2 for multipliers x9 to x2), of any length (1 to 64 dividers). At rotation R, output jack i is
+// using divider (i + R) modulo length, so a table have as many possible rotations as its length (shorter tables are repeated).
+// Like built-in tables, all rotations are expanded into flat rows, but when tables are loaded (never on audio thread).
+struct RKDUserTables {
+	// Number of (valid) loaded tables.
+	int count = 0;
+	// Table names (shown in context-menu), and dividers as defined (to save them into patch).
+	std::string names[RKD_MAX_USER_TABLES];
+	std::vector<int> dividers[RKD_MAX_USER_TABLES];
+	// Rows of dividers (all rotations, for all tables).
+	int8_t rows[RKD_MAX_USER_TABLES * RKD_MAX_USER_TABLE_LENGTH][8];
+	// First row, number of possible rotations and highest divider (used as "Max Div" amount), per table.
+	int rowFirst[RKD_MAX_USER_TABLES];
+	int rowCount[RKD_MAX_USER_TABLES];
+	int maxDiv[RKD_MAX_USER_TABLES];
+
+	// Building tables from json array, eg [{"name": "Odd meters", "dividers": [3, 5, 7, 9, 11, 13, 15]}, ...].
+	// Non-compliant tables are ignored. Returns number of loaded tables.
+	int fromJson(json_t *userTablesJ) {
+		count = 0;
+		if (!json_is_array(userTablesJ))
+			return 0;
+		size_t t;
+		json_t *tableJ;
+		int nRow = 0;
+		json_array_foreach(userTablesJ, t, tableJ) {
+			if (count >= RKD_MAX_USER_TABLES) {
+				WARN("RKD: too many user tables, only first %d are loaded", RKD_MAX_USER_TABLES);
+				break;
+			}
+			json_t *nameJ = json_object_get(tableJ, "name");
+			json_t *dividersJ = json_object_get(tableJ, "dividers");
+			size_t length = json_array_size(dividersJ);
+			if (!json_is_array(dividersJ) || (length < 1) || (length > RKD_MAX_USER_TABLE_LENGTH)) {
+				WARN("RKD: user table #%d ignored (\"dividers\" must be an array of 1 to %d dividers)", (int)(t + 1), RKD_MAX_USER_TABLE_LENGTH);
+				continue;
+			}
+			std::vector<int> tableDividers;
+			bool bCompliant = true;
+			size_t d;
+			json_t *dividerJ;
+			json_array_foreach(dividersJ, d, dividerJ) {
+				int divider = json_is_integer(dividerJ) ? (int)json_integer_value(dividerJ) : 0;
+				if ((divider < -RKD_MAX_MULTIPLIER) || (divider == -1) || (divider == 0) || (divider > 64)) {
+					bCompliant = false;
+					break;
+				}
+				tableDividers.push_back(divider);
+			}
+			if (!bCompliant) {
+				WARN("RKD: user table #%d ignored (dividers must be integers, between 1 and 64, or between -%d and -2 for multipliers)", (int)(t + 1), RKD_MAX_MULTIPLIER);
+				continue;
+			}
+			// Table is compliant.
+			if (json_is_string(nameJ) && (json_string_value(nameJ)[0] != '\0'))
+				names[count] = json_string_value(nameJ);
+				else names[count] = "User table " + std::to_string(count + 1);
+			int nRotations = (int)(tableDividers.size());
+			rowFirst[count] = nRow;
+			rowCount[count] = nRotations;
+			maxDiv[count] = std::max(1, *std::max_element(tableDividers.begin(), tableDividers.end())); // Multipliers-only table: Max Div is 1.
+			for (int r = 0; r < nRotations; r++) {
+				for (int i = 0; i < 8; i++)
+					rows[nRow][i] = (int8_t)tableDividers[(i + r) % nRotations];
+				nRow++;
+			}
+			dividers[count] = tableDividers;
+			count++;
+		}
+		return count;
+	}
+
+	// Returns tables as json array (same format).
+	json_t *toJson() {
+		json_t *userTablesJ = json_array();
+		for (int t = 0; t < count; t++) {
+			json_t *tableJ = json_object();
+			json_object_set_new(tableJ, "name", json_string(names[t].c_str()));
+			json_t *dividersJ = json_array();
+			for (int divider : dividers[t])
+				json_array_append_new(dividersJ, json_integer(divider));
+			json_object_set_new(tableJ, "dividers", dividersJ);
+			json_array_append_new(userTablesJ, tableJ);
+		}
+		return userTablesJ;
+	}
+
+};
 
 struct RKD : Module {
 	enum ParamIds {
@@ -52,31 +155,23 @@ struct RKD : Module {
 		NUM_LIGHTS
 	};
 
-	// Used for BRK expander (states of six switches).
-	bool rightMessages[2][NUM_PARAMS] = {}; // Messages from right-side BRK expander (default).
-	bool leftMessages[2][NUM_PARAMS] = {}; // Messages from left-side BRK expander (default).
+	// Used for BRK expander (states of six switches), or RKX expander (CYCLE CV).
+	RKDExpanderMessage rightMessages[2]; // Messages from right-side expander (default).
+	RKDExpanderMessage leftMessages[2]; // Messages from left-side expander.
+	// Last applied BRK message (sender and generation), its switches (one bit per jumper, -1 while BRK isn't attached), and rotation
+	// offset given by BRK.
+	int64_t brkSenderId = -1;
+	uint32_t brkGeneration = 0;
+	int brkSwitches = -1;
+	int brkRotateOffset = 0;
+	// Jumpers/switches setting (one bit per jumper), used to detect a change (-1 forces reading).
+	int jumpersPrev = -1;
 	// Sample rate.
 	float sampleRate = 44100.0f; // Default 44100 Hz for sample rate.
 	// This flag indicates if jumpers (PCB) is visible, or not (only RKD module).
 	bool bViewPCB = false;
 	// This flag is set when module is running (CLK jack is wired).
 	bool bCLKisActive = false;
-	// This flag is set when module is unwired (CLK jack is unwired).
-	bool bDisplayNoDividers = true;
-	// Schmitt trigger, for RESET input port.
-	dsp::SchmittTrigger RESET_Port;
-	// Schmitt trigger, for CLK input port.
-	dsp::SchmittTrigger CLK_Port;
-	// This flag, when true, indicates the CLK rising edge at the current step.
-	bool bIsRisingEdge = false;
-	// Next incoming rising edge will be the first rising edge. Required to handle gate modes together with counting up or down.
-	bool bIsEarlyRisingEdge = true;
-	// This flag, when true, indicates the CLK falling edge at the current step.
-	bool bIsFallingEdge = false;
-	// This flag, when true, indicates the CLK is high (voltage equal or higher +2V).
-	bool bCLKisHigh = false;
-	// Assumed timeout at start.
-	bool bCLKTimeOut = true;
 	// Default jumpers/switches setting (false = Off, true = On).
 	bool jmprCountingDown = false; // Factory is Off: Counting Up.
 	bool _jmprCountingDown = false;
@@ -89,68 +184,77 @@ struct RKD : Module {
 	bool jmprSpread = false; // Factory is Off: Spread Off.
 	bool _jmprSpread = false;
 	bool jmprAutoReset = false; // Factory is Off = Auto-Reset Off.
-	// Table set (0: Manufacturer, 1: Prime numbers, 2: Perfect squares, 3: Fibonacci sequence, 4: Triplet & 16ths).
+	// Table set (0: Manufacturer, 1: Prime numbers, 2: Perfect squares, 3: Fibonacci sequence, 4: Triplet & 16ths, 5: Multipliers, from 8: user tables).
 	int tableSet = 0; // This variable is persistent (json).
 	int tableSetPrev = 0; // Used to change detection across consecutive steps.
-	// RKD default dividers table.
-	int tblDividersR0[NUM_OUTPUTS] = {1, 2, 3, 4, 5, 6, 7, 8}; // default dividers (R+0) when using factory jumpers/switches setting.
-	// Prime numbers base table.
-	int tblPrimes[18] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61};
-	// Perfect squares base table.
-	int tblSquares[8] = {1, 4, 9, 16, 25, 36, 49, 64};
-	// Fibonacci sequence base table.
-	int tblFibonacci[9] = {1, 2, 3, 5, 8, 13, 21, 34, 55};
-	// Triplet & 16ths table.
-	int tblTripletSixteenths[8] = {1, 2, 3, 4, 8, 16, 32, 64};
-	// Current (active) dividers table.
-	int tblActiveDividers[NUM_OUTPUTS] = {1, 2, 3, 4, 5, 6, 7, 8};
-	// Rotation dividers table (as prepared table).
-	// Future dividers table, when rotation is required. Last value of this array will be used as "temp backup/restore", during rotation.
-	int tblDividersRt[NUM_OUTPUTS + 1] = {1, 2, 3, 4, 5, 6, 7, 8, 0};
+	// User tables, double-buffered: new tables are loaded (from UI thread) into the unused buffer, then this one becomes active.
+	RKDUserTables userTables[2];
+	std::atomic<int> userTablesActive {0}; // Set by loader (UI thread).
+	std::atomic<int> userTablesInUse {0}; // Set by audio thread, as soon as it's using active buffer.
+	// Reload of user tables file requested via context-menu (UI thread only): done by module widget as soon as previous loaded tables
+	// are in use by audio thread.
+	bool bUserTablesReloadPending = false;
 	// When set (armed), indicates table have been changed (eg after jumper/switch change/context-menu table).
 	bool bTableChange = true;
-	// When set (armed), prepare the rotation (set new dividers table).
-	bool bDoRotation = false;
-	// When set (armed), doing rotation on next rising-edge (coming on CLK input port).
-	bool bDoRotationOnRisingEdge = false;
-	// Displayed dividers into segment-LED displays (assuming defaults are "--" because the CLK isn't patched).
-	char dispDiv1[3] = "--";
-	char dispDiv2[3] = "--";
-	char dispDiv3[3] = "--";
-	char dispDiv4[3] = "--";
-	char dispDiv5[3] = "--";
-	char dispDiv6[3] = "--";
-	char dispDiv7[3] = "--";
-	char dispDiv8[3] = "--";
-	// Maximum divide amount, default is 8 (for manufacter table).
-	int maxDivAmount = 8;
-	// ROTATE (CV) voltage.
-	float cvRotate = 0.0f;
-	int cvRotateTblIndex = 0;
-	int cvRotateTblIndexPrevious = 0;
-	// RESET voltage (trigger input port).
-	float cvReset = 0.0f;
-	bool bResetOnJack = false;
-	bool bRegisteredResetOnJack = false;
-	// Step-based (sample) counters.
-	long long int currentStep = 0;
-	long long int previousStep = 0;
-	long long int expectedStep = 0;
-	// Source (CLK) frequency flag (set when source frequency is known).
-	bool bCLKFreqKnown = false;
-	// Dividers counters (one per output jack).
-	int divCounters[NUM_OUTPUTS] = {0, 0, 0, 0, 0, 0, 0, 0};
-	// Global Auto-Reset sequence counter.
-	int divCountersAutoReset = 0;
-	// This flag is set on "Auto-Reset" event.
-	bool bIsAutoReset = false;
-	// This flag allow/inhibit Auto-Reset - temporary (Auto-Reset will not fired after a timeout/reset, or a reset done via RESET jack).
-	bool bAllowAutoReset = false;
-	// This flag is used only for blue RESET (Auto-Reset) LED (too avoid too long flashing LED).
-	bool bAutoResetLEDfired = false;
-	// True if output jack is fired (pulsing).
-	bool bJackIsFired[NUM_OUTPUTS] = {false, false, false, false, false, false, false, false};
-	// RESET LED afterglow (0: end of afterglow/unlit LED, other positive values indicate how many steps the LED is lit.
+	// Displayed dividers into segment-LED displays (first channel), as lock-free snapshot: one signed byte per divider (negative values
+	// are multipliers, displayed as "x2" for example, and 0 is displayed as "--",
+	// assuming default because the CLK isn't patched). Published by audio thread, read (and formatted) by display widget.
+	std::atomic<uint64_t> displayDividers {0};
+	// LEDs and displays are updated at UI rate (not every sample).
+	dsp::ClockDivider lightDivider;
+	// Latched LED events (first channel) between two LEDs updates: CLK rising edge, RESET via jack, and output jacks fired.
+	bool bLedClkLatched = false;
+	bool bLedResetOnJackLatched = false;
+	uint32_t ledOutputsLatched = 0;
+	// RKX expander: dividers factor (RKX dividers are RKD dividers multiplied by this factor). This variable is persistent (json).
+	int rkxFactor = 2;
+	int rkxFactorPrev = 2;
+	// RKX expander module (if placed alongside RKD), or nullptr. RKX output jacks and LEDs are written by RKD itself, in the same sample
+	// as RKD output jacks (RKX doesn't touch them while attached). Previous RKX module is used to detect a newly attached RKX.
+	Module *rkxModule = nullptr;
+	Module *rkxModulePrev = nullptr;
+	// ROTATE CV slew time (in seconds, 0 means no slew), set via context-menu (UI thread). Slew coefficient of dividers engine is
+	// computed again by audio thread (at top of "process()") when change flag is set, eg after sample rate change. This variable is
+	// persistent (json).
+	std::atomic<float> rotateSlewTime {0.0f};
+	std::atomic<bool> bRotateSlewChange {true};
+	// Auto-Reset cycle (0: "2 x Max Div", factory), set via context-menu. This variable is persistent (json).
+	int autoResetCycle = 0;
+	// Dividers engine (all channels). Its clock tracker, groove and probability settings are persistent (json).
+	RKDEngine engine;
+	// Groove settings (swing and humanise per RKD output jack, and humanise seed), as set via context-menu (UI thread). They're applied
+	// to dividers engine by audio thread, at top of "process()", when change flag is set.
+	std::atomic<float> swingSetting[8];
+	std::atomic<float> humaniseSetting[8];
+	std::atomic<uint32_t> humaniseSeedSetting {RKD_HUMANISE_DEFAULT_SEED};
+	std::atomic<bool> bGrooveSettingChange {false};
+	// Probability settings (per RKD output jack, and seed), as set via context-menu (UI thread). Like groove settings, they're applied to
+	// dividers engine by audio thread.
+	std::atomic<float> probabilitySetting[8];
+	std::atomic<uint32_t> probabilitySeedSetting {RKD_PROBABILITY_DEFAULT_SEED};
+	std::atomic<bool> bProbabilitySettingChange {false};
+	// Clock period tracker settings (tolerance window, and timeout), as set via context-menu (UI thread). Like groove settings, they're
+	// applied to dividers engine by audio thread.
+	std::atomic<float> clkToleranceSetting {0.05f};
+	std::atomic<int> clkTimeoutPeriodsSetting {2};
+	std::atomic<bool> bClockSettingChange {false};
+	// Polyphony: number of channels (given by CLK input cable).
+	int nChannels = 1;
+	// Cycle analysis (first channel): snapshot of active dividers (1 for multipliers), dividers counters and Auto-Reset cycle, published
+	// by audio thread (one unsigned byte per RKD output jack, 0 while CLK isn't connected). Auto-Reset is packed as "active" flag (bit
+	// 31), cycle length (bits 16 to 30) and counter (bits 0 to 15).
+	std::atomic<uint64_t> cycleDividers {0};
+	std::atomic<uint64_t> cycleCounters {0};
+	std::atomic<uint32_t> cycleAutoReset {0};
+	// Cycle analysis, done by UI thread (module widget) when snapshot has changed, never by audio thread: analysed snapshot, and result.
+	uint64_t cycleAnalysedDividers = 0;
+	uint64_t cycleAnalysedCounters = 0;
+	uint32_t cycleAnalysedAutoReset = 0;
+	RKDCycleAnalysis cycleAnalysis;
+	// Segment-LED displays are showing cycle analysis (pattern length, then next coincidence) instead of dividers. This variable is
+	// persistent (json).
+	bool bCycleReadout = false;
+	// RESET LED afterglow (0 or less: end of afterglow/unlit LED, other positive values indicate how many steps the LED is lit.
 	int ledResetAfterglow = 0;
 
 	RKD() {
@@ -184,11 +288,11 @@ struct RKD : Module {
 		configBypass(CLK_INPUT, OUTPUT_7);
 		configBypass(CLK_INPUT, OUTPUT_8);
 		// BRK module as expander (right-side of RKD - default and have priority aka possible left-side is ignored).
-		rightExpander.producerMessage = rightMessages[0];
-		rightExpander.consumerMessage = rightMessages[1];
+		rightExpander.producerMessage = &rightMessages[0];
+		rightExpander.consumerMessage = &rightMessages[1];
 		// BRK module as expander (left-side of RKD - only if they're another BRK at right-side).
-		leftExpander.producerMessage = leftMessages[0];
-		leftExpander.consumerMessage = leftMessages[1];
+		leftExpander.producerMessage = &leftMessages[0];
+		leftExpander.consumerMessage = &leftMessages[1];
 		//
 		sampleRate = (float)(APP->engine->getSampleRate());
 		jmprCountingDown = false;
@@ -203,9 +307,13 @@ struct RKD : Module {
 		_jmprSpread = false;
 		jmprAutoReset = false;
 		tableSet = 0;
-		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-			tblDividersR0[i] = i + 1; // Default dividers for all output ports (manufacturer table).
-		maxDivAmount = 8; // Default factory maximum divide amount is 8.
+		nChannels = 1;
+		lightDivider.setDivision(256);
+		getGrooveSettings();
+		getProbabilitySettings();
+		getClockSettings();
+		// Loading user tables file (if exists).
+		loadUserTablesFile(true);
 		ModuleTimeOut(); // Set module in timeout (sleeping) mode, to reset some variables/flags/counters...
 	}
 
@@ -213,92 +321,162 @@ struct RKD : Module {
 
 	void onSampleRateChange() override {
 		sampleRate = (float)(APP->engine->getSampleRate());
-	}		
+		bRotateSlewChange.store(true);
+	}
+
+	// ROTATE CV (optional) slew: one-pole lowpass, having given time constant (in seconds, 0 means no slew). Coefficient is computed by
+	// audio thread.
+	void setRotateSlew(float givenSlewTime) {
+		rotateSlewTime.store(givenSlewTime);
+		bRotateSlewChange.store(true);
+	}
+
+	// Applying ROTATE CV slew time (or sample rate) change to dividers engine (audio thread).
+	void applyRotateSlew() {
+		float slewTime = rotateSlewTime.load();
+		engine.rotateSlewCoef = (slewTime > 0.0f) ? (1.0f - std::exp(-1.0f / (slewTime * sampleRate))) : 1.0f;
+	}
 
 	void ModuleTimeOut() {
-		// Reset Schmitt trigger used by RESET input jack.
-		RESET_Port.reset();
-		// Defining trigger thresholds for RESET input jack (rescale).
-		//RESET_Port.setThresholds(0.2f, 3.5f);
-		bResetOnJack = false;
-		bRegisteredResetOnJack = false;
-		// Reset Schmitt trigger used by CLK input jack.
-		CLK_Port.reset();
-		// Defining thresholds for CLK input jack (rescale).
-		//CLK_Port.setThresholds(0.2f, 3.5f);
-		// CLK is low (not wired = no signal = false).
-		bCLKisHigh = false;
-		// Reset ROTATE indexes.
-		cvRotateTblIndex = 0;
-		cvRotateTblIndexPrevious = 0;
-		// Table rotation is on Initialize. For now we're using standard "R+0" base table.
-		bDoRotation  = true;
-		bDoRotationOnRisingEdge = false;
-		//
-		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++) {
-			divCounters[i] = 0; // Reset all dividers counters to 0 (for all output jacks).
-			pulseOutputJack(i, false); // Be sure this jack isn't pulsing.
+		// All channels are in timeout.
+		for (int c = 0; c < PORT_MAX_CHANNELS; c++)
+			ChannelTimeOut(c);
+	}
+
+	void ChannelTimeOut(int c) {
+		engine.timeOut(c);
+		// All output jacks are low.
+		writeOutputJacks(c);
+	}
+
+	// Loading user tables from json array. While engine is idle (constructor, or "dataFromJson"), active buffer is directly updated.
+	// Otherwise, tables are loaded into unused buffer, but only if previous loaded tables are already in use by audio thread.
+	bool loadUserTables(json_t *userTablesJ, bool bEngineIdle) {
+		int active = userTablesActive.load();
+		if (bEngineIdle) {
+			userTables[active].fromJson(userTablesJ);
+			bTableChange = true;
+			return true;
 		}
-		// Reset "Auto-Reset" counter and related flags.
-		divCountersAutoReset = 0;
-		bIsAutoReset = false;
-		bAllowAutoReset = false;
-		bAutoResetLEDfired = false;
-		// Unlit CLK LED.
-		lights[LED_CLK].setBrightness(0.0f);
-		// Source (CLK) frequency is reset (because CLK signal is lost/absent).
-		bCLKFreqKnown = false;
-		// Reset step-based counters.
-		currentStep = 0;
-		previousStep = 0;
-		expectedStep = 0;
-		// Early rising edge flag. When set, this meaning the next rising edge will be considered as early (first) rising edge. Required for gate modes!
-		bIsEarlyRisingEdge = true;
-		// Set time out flag (this will lit RESET red LED).
-		bCLKTimeOut = true;
+		if (userTablesInUse.load() != active)
+			return false;
+		userTables[1 - active].fromJson(userTablesJ);
+		userTablesActive.store(1 - active);
+		return true;
 	}
 
-	// Pulse manager.
-	void pulseOutputJack(int givenOutputJack, bool bJackPulseState) {
-		outputs[givenOutputJack].setVoltage((bJackPulseState ? 5.0f : 0.0f));
-		lights[givenOutputJack].setBrightness((bJackPulseState ? 1.0f : 0.0f));
-		bJackIsFired[givenOutputJack] = bJackPulseState;
+	// Loading user tables from plugin-wide file, eg {"userTables": [{"name": "Odd meters", "dividers": [3, 5, 7, 9, 11, 13, 15]}]}.
+	bool loadUserTablesFile(bool bEngineIdle) {
+		std::string path = asset::user("Ohmer/RKD-user-tables.json");
+		if (!system::isFile(path))
+			return false;
+		json_error_t error;
+		json_t *rootJ = json_load_file(path.c_str(), 0, &error);
+		if (!rootJ) {
+			WARN("RKD: can't parse %s (line %d: %s)", path.c_str(), error.line, error.text);
+			return false;
+		}
+		bool bLoaded = loadUserTables(json_object_get(rootJ, "userTables"), bEngineIdle);
+		json_decref(rootJ);
+		return bLoaded;
 	}
 
-	void process(const ProcessArgs &args) override {
-		// DSP processing...
+	// Pending reload of user tables file (from UI thread), done as soon as unused buffer is available.
+	void processUserTablesReload() {
+		if (!bUserTablesReloadPending || (userTablesInUse.load() != userTablesActive.load()))
+			return;
+		bUserTablesReloadPending = false;
+		loadUserTablesFile(false);
+	}
 
-		// BRK expander module handling (if BRK placed along right-side of RKD).
-		if ((rightExpander.module && rightExpander.module->model == modelBRK)) {
-			// BRK at right-side of RKD: receiving state of switches from BRK and update jumpers.
-			// Note right-side takes over another left-side!
-			bool *message = (bool*)rightExpander.consumerMessage;
-			params[JUMPER_COUNTINGDOWN].setValue(message[JUMPER_COUNTINGDOWN] ? 1.0 : 0.0);
-			params[JUMPER_GATE].setValue(message[JUMPER_GATE] ? 1.0 : 0.0);
-			params[JUMPER_MAXDIVRANGE16].setValue(message[JUMPER_MAXDIVRANGE16] ? 1.0 : 0.0);
-			params[JUMPER_MAXDIVRANGE32].setValue(message[JUMPER_MAXDIVRANGE32] ? 1.0 : 0.0);
-			params[JUMPER_SPREAD].setValue(message[JUMPER_SPREAD] ? 1.0 : 0.0);
-			params[JUMPER_AUTORESET].setValue(message[JUMPER_AUTORESET] ? 1.0 : 0.0);
+	// Cycle analysis (from UI thread), only if snapshot published by audio thread has changed since previous analysis. Analysis is
+	// bounded (eight dividers upto 64, Auto-Reset cycle upto 256 clocks), so it's cheap enough for UI thread.
+	void updateCycleAnalysis() {
+		uint64_t packedDividers = cycleDividers.load();
+		uint64_t packedCounters = cycleCounters.load();
+		uint32_t packedAutoReset = cycleAutoReset.load();
+		if ((packedDividers == cycleAnalysedDividers) && (packedCounters == cycleAnalysedCounters) && (packedAutoReset == cycleAnalysedAutoReset))
+			return;
+		cycleAnalysedDividers = packedDividers;
+		cycleAnalysedCounters = packedCounters;
+		cycleAnalysedAutoReset = packedAutoReset;
+		int dividers[RKD_NUM_OUTPUTS];
+		int counters[RKD_NUM_OUTPUTS];
+		for (int i = 0; i < RKD_NUM_OUTPUTS; i++) {
+			dividers[i] = (int)((packedDividers >> (8 * i)) & 0xff);
+			counters[i] = (int)((packedCounters >> (8 * i)) & 0xff);
 		}
-		else if ((leftExpander.module && leftExpander.module->model == modelBRK)) {
-			// BRK at left-side of RKD: receiving state of switches from BRK and update jumpers.
-			bool *message = (bool*)leftExpander.consumerMessage;
-			params[JUMPER_COUNTINGDOWN].setValue(message[JUMPER_COUNTINGDOWN] ? 1.0 : 0.0);
-			params[JUMPER_GATE].setValue(message[JUMPER_GATE] ? 1.0 : 0.0);
-			params[JUMPER_MAXDIVRANGE16].setValue(message[JUMPER_MAXDIVRANGE16] ? 1.0 : 0.0);
-			params[JUMPER_MAXDIVRANGE32].setValue(message[JUMPER_MAXDIVRANGE32] ? 1.0 : 0.0);
-			params[JUMPER_SPREAD].setValue(message[JUMPER_SPREAD] ? 1.0 : 0.0);
-			params[JUMPER_AUTORESET].setValue(message[JUMPER_AUTORESET] ? 1.0 : 0.0);
+		int autoResetLength = ((packedAutoReset & 0x80000000) ? (int)((packedAutoReset >> 16) & 0x7fff) : 0);
+		cycleAnalysis = rkdAnalyseCycle(dividers, counters, autoResetLength, (int)(packedAutoReset & 0xffff));
+	}
+
+	// Returns latest cycle analysis (from UI thread).
+	RKDCycleAnalysis getCycleAnalysis() {
+		return cycleAnalysis;
+	}
+
+	// Groove settings (context-menu) are copied from dividers engine (constructor, or "dataFromJson", while engine is idle).
+	void getGrooveSettings() {
+		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++) {
+			swingSetting[i].store(engine.swing[i]);
+			humaniseSetting[i].store(engine.humanise[i]);
+		}
+		humaniseSeedSetting.store(engine.humaniseSeed);
+	}
+
+	// Applying groove settings (changed via context-menu) to dividers engine (audio thread).
+	void applyGrooveSettings() {
+		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++) {
+			engine.swing[i] = swingSetting[i].load();
+			engine.humanise[i] = humaniseSetting[i].load();
 		}
+		if (humaniseSeedSetting.load() != engine.humaniseSeed)
+			engine.setHumaniseSeed(humaniseSeedSetting.load());
+		engine.setGroove();
+	}
+
+	// Probability settings (context-menu) are copied from dividers engine (constructor, or "dataFromJson", while engine is idle).
+	void getProbabilitySettings() {
+		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
+			probabilitySetting[i].store(engine.probability[i]);
+		probabilitySeedSetting.store(engine.probabilitySeed);
+	}
+
+	// Applying probability settings (changed via context-menu) to dividers engine (audio thread). A new seed is used from next timeout.
+	void applyProbabilitySettings() {
+		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
+			engine.probability[i] = probabilitySetting[i].load();
+		engine.probabilitySeed = probabilitySeedSetting.load();
+		engine.setProbability();
+	}
+
+	// Clock period tracker settings (context-menu) are copied from dividers engine (constructor, or "dataFromJson", while engine is idle).
+	void getClockSettings() {
+		clkToleranceSetting.store(engine.clkTolerance);
+		clkTimeoutPeriodsSetting.store(engine.clkTimeoutPeriods);
+	}
+
+	// Applying clock period tracker settings (changed via context-menu) to dividers engine (audio thread).
+	void applyClockSettings() {
+		engine.clkTolerance = clkToleranceSetting.load();
+		engine.clkTimeoutPeriods = clkTimeoutPeriodsSetting.load();
+	}
 
-		// Reading jumpers/switches setting.
+	// Returns true if given table set is available (built-in, or loaded user table).
+	bool isTableSetAvailable(int givenTableSet) {
+		if ((givenTableSet >= 0) && (givenTableSet < RKD_NUM_TABLESETS))
+			return true;
+		return (givenTableSet >= RKD_FIRST_USER_TABLESET) && (givenTableSet < RKD_FIRST_USER_TABLESET + userTables[userTablesActive.load()].count);
+	}
+
+	// Reading jumpers/switches setting.
+	void readJumpers() {
 		jmprGate = (params[JUMPER_GATE].getValue() == 1.0);
 		_jmprGate = jmprGate;
+		engine.bGate = jmprGate;
 		jmprCountingDown = (params[JUMPER_COUNTINGDOWN].getValue() == 1.0);
-		// Gate mode only: if "Counting" is changed on the fly, invert firing status for each output jack.
-		if ((jmprGate) && (_jmprCountingDown != jmprCountingDown))
-			for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-				bJackIsFired[i] = !bJackIsFired[i];
+		// Gate mode only: if "Counting" is changed on the fly, engine inverts firing status for each output jack (all channels).
+		engine.setCountingDown(jmprCountingDown);
 		_jmprCountingDown = jmprCountingDown;
 		jmprMaxDivRange16 = (params[JUMPER_MAXDIVRANGE16].getValue() == 1.0);
 		bTableChange = bTableChange || (jmprMaxDivRange16 != _jmprMaxDivRange16);
@@ -311,465 +489,208 @@ struct RKD : Module {
 			bTableChange = bTableChange || (jmprSpread != _jmprSpread); // Spread concerns manufacturer table only. Have no effect on other tables.
 		_jmprSpread = jmprSpread;
 		jmprAutoReset = (params[JUMPER_AUTORESET].getValue() == 1.0);
-		// Checking if table set was changed via context-menu.
+		engine.bAutoReset = jmprAutoReset;
+	}
+
+	void process(const ProcessArgs &args) override {
+		// DSP processing...
+
+		// Groove settings changed via context-menu?
+		if (bGrooveSettingChange.load(std::memory_order_relaxed) && bGrooveSettingChange.exchange(false))
+			applyGrooveSettings();
+		// Probability settings changed via context-menu?
+		if (bProbabilitySettingChange.load(std::memory_order_relaxed) && bProbabilitySettingChange.exchange(false))
+			applyProbabilitySettings();
+		// Clock period tracker settings changed via context-menu?
+		if (bClockSettingChange.load(std::memory_order_relaxed) && bClockSettingChange.exchange(false))
+			applyClockSettings();
+		// ROTATE CV slew time (or sample rate) changed?
+		if (bRotateSlewChange.load(std::memory_order_relaxed) && bRotateSlewChange.exchange(false))
+			applyRotateSlew();
+
+		// BRK expander module handling (if BRK placed along right-side of RKD - note right-side takes over another left-side!).
+		BRKMessage *brkMessage = nullptr;
+		Module *brkModule = nullptr;
+		if ((rightExpander.module && rightExpander.module->model == modelBRK)) {
+			brkModule = rightExpander.module;
+			brkMessage = &((RKDExpanderMessage*)rightExpander.consumerMessage)->brk;
+		}
+		else if ((leftExpander.module && leftExpander.module->model == modelBRK)) {
+			brkModule = leftExpander.module;
+			brkMessage = &((RKDExpanderMessage*)leftExpander.consumerMessage)->brk;
+		}
+		if (!brkModule) {
+			brkSwitches = -1;
+			brkRotateOffset = 0;
+		}
+		// Receiving state of switches from BRK and update jumpers, only if BRK has sent a new message.
+		if (brkMessage && (brkMessage->version >= 1) && (brkMessage->senderId == brkModule->id) && ((brkMessage->senderId != brkSenderId) || (brkMessage->generation != brkGeneration))) {
+			brkSenderId = brkMessage->senderId;
+			brkGeneration = brkMessage->generation;
+			brkSwitches = 0;
+			for (int i = JUMPER_COUNTINGDOWN; i < NUM_PARAMS; i++)
+				if (brkMessage->switches[i])
+					brkSwitches |= 1 << i;
+			if ((brkMessage->tableSet >= 0) && isTableSetAvailable(brkMessage->tableSet))
+				tableSet = brkMessage->tableSet;
+			brkRotateOffset = std::max(0, brkMessage->rotateOffset);
+		}
+
+		engine.rotateOffset = brkRotateOffset;
+
+		// Jumpers/switches setting is read only when (at least) one of them was changed (via PCB, or BRK).
+		int jumpers = 0;
+		for (int i = JUMPER_COUNTINGDOWN; i < NUM_PARAMS; i++)
+			if (params[i].getValue() == 1.0)
+				jumpers |= 1 << i;
+		// While BRK is attached, its switches are in control: jumpers are (re)applied from last BRK message as soon as they differ (new
+		// message, or jumper changed via PCB), so RKD and BRK never disagree.
+		if ((brkSwitches >= 0) && (jumpers != brkSwitches)) {
+			for (int i = JUMPER_COUNTINGDOWN; i < NUM_PARAMS; i++)
+				params[i].setValue((brkSwitches & (1 << i)) ? 1.0 : 0.0);
+			jumpers = brkSwitches;
+		}
+		if (jumpers != jumpersPrev) {
+			jumpersPrev = jumpers;
+			readJumpers();
+		}
+		// Are new user tables loaded?
+		int userTablesIndex = userTablesActive.load();
+		if (userTablesIndex != userTablesInUse.load()) {
+			userTablesInUse.store(userTablesIndex);
+			bTableChange = true;
+		}
+		// Selected user table may no longer exist: back to manufacturer table.
+		if (!isTableSetAvailable(tableSet))
+			tableSet = 0;
+		// Checking if table set (or RKX factor) was changed via context-menu.
 		if (!bTableChange)
-			bTableChange = (tableSetPrev != tableSet);
+			bTableChange = (tableSetPrev != tableSet) || (rkxFactorPrev != rkxFactor);
 		// Is table change?
 		if (bTableChange) {
 			// Yep! assuming table have been changed (either by jumpers/switches setting, or table set via module's context-menu).
-			if (tableSet == 0) {
-				// Define new "Mav Div" amount, regardling current "Max-Div-Range 16", "Max-Div-Range 32" and "Spread" jumpers/switches setting.
-				if (jmprMaxDivRange16 && jmprMaxDivRange32 && jmprSpread)
-					maxDivAmount = 16; // Max-Div-Range 16 = On, Max-Div-Range 32 = On: Max Div = 8, but Spread On --> Max Div 16.
-					else if (jmprMaxDivRange16 && jmprMaxDivRange32 && !jmprSpread)
-						maxDivAmount = 8; // Max-Div-Range 16 = On, Max-Div-Range 32 = On, Spread Off: Max Div = 8 (it's the default factory).
-						else if (jmprMaxDivRange16 && !jmprMaxDivRange32)
-							maxDivAmount = 16; // Max-Div-Range 16 = On, Max-Div-Range 32 = Off: Max Div = 16.
-							else if (!jmprMaxDivRange16 && jmprMaxDivRange32)
-								maxDivAmount = 32; // Max-Div-Range 16 = Off, Max-Div-Range 32 = On: Max Div = 32.
-								else maxDivAmount = 64; // Last possible remaining case is... Max-Div-Range 16 = Off, Max-Div-Range 32 = Off: Max Div = 64.
+			// First precomputed row (R+0) for current table set and jumpers/switches setting, its number of possible rotations, and maximum
+			// divide amount (default is 8, for manufacter table).
+			const int8_t (*rotationRows)[8];
+			int rotationRowCount;
+			int maxDivAmount;
+			if (tableSet < RKD_NUM_TABLESETS) {
+				// Built-in tables.
+				if (tableSet == 0)
+					maxDivAmount = RKDRotationTables::getManufacturerMaxDiv(jmprMaxDivRange16, jmprMaxDivRange32, jmprSpread);
+					else maxDivAmount = 64; // Max Div = 64 for all "extra" tables.
+				// Now we're defining "future" table (R+0), from precomputed rows.
+				int jumpersCombo = (jmprMaxDivRange16 ? 4 : 0) + (jmprMaxDivRange32 ? 2 : 0) + (jmprSpread ? 1 : 0);
+				rotationRows = &rkdRotationTables.rows[rkdRotationTables.rowFirst[tableSet][jumpersCombo]];
+				rotationRowCount = rkdRotationTables.rowCount[tableSet][jumpersCombo];
 			}
-			else maxDivAmount = 64; // Max Div = 64 for all "extra" tables.
-
-			switch (tableSet) {
-				case 0:
-					// Now we're defining "future" table, but based on "Manufacturer" table.
-					if (jmprMaxDivRange16 && jmprMaxDivRange32 && jmprSpread) {
-						// Max-Div-Range 16 = On, Max-Div-Range 32 = On, Spread = On.
-						// Special case of "musical" divisions (triplets, 16ths).
-						tblDividersR0[OUTPUT_1] = 1;
-						tblDividersR0[OUTPUT_2] = 2;
-						tblDividersR0[OUTPUT_3] = 3;
-						tblDividersR0[OUTPUT_4] = 4;
-						tblDividersR0[OUTPUT_5] = 6;
-						tblDividersR0[OUTPUT_6] = 8;
-						tblDividersR0[OUTPUT_7] = 12;
-						tblDividersR0[OUTPUT_8] = 16;
-					}
-					else if (jmprMaxDivRange16 && jmprMaxDivRange32 && !jmprSpread) {
-						// Max-Div-Range 16 = On, Max-Div-Range 32 = On, Spread = Off (factory setting).
-						for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-							tblDividersR0[i] = i + 1;
-					}
-					else if (jmprMaxDivRange16 && !jmprMaxDivRange32 && jmprSpread) {
-						// Max-Div-Range 16 is On, Max-Div-Range 32 is Off, Spread is On.
-						for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-							tblDividersR0[i] = 2 * i + 2;
-					}
-					else if (jmprMaxDivRange16 && !jmprMaxDivRange32 && !jmprSpread) {
-						// Max-Div-Range 16 is On, Max-Div-Range 32 is Off, Spread is Off.
-						for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-							tblDividersR0[i] = i + 9;
-					}
-					else if (!jmprMaxDivRange16 && jmprMaxDivRange32 && jmprSpread) {
-						// Max-Div-Range 16 is Off, Max-Div-Range 32 is On, Spread is On.
-						for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-							tblDividersR0[i] = 4 * i + 4;
-					}
-					else if (!jmprMaxDivRange16 && jmprMaxDivRange32 && !jmprSpread) {
-						// Max-Div-Range 16 is Off, Max-Div-Range 32 is On, Spread is Off.
-						for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-							tblDividersR0[i] = i + 17;
-					}
-					else if (!jmprMaxDivRange16 && !jmprMaxDivRange32 && jmprSpread) {
-						// Max-Div-Range 16 is Off, Max-Div-Range 32 is Off, Spread is On.
-						for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-							tblDividersR0[i] = 8 * i + 8;
-					}
-					else if (!jmprMaxDivRange16 && !jmprMaxDivRange32 && !jmprSpread) {
-						// Last possibility: Max-Div-Range 16 is Off, Max-Div-Range 32 is Off, Spread is Off.
-						for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-							tblDividersR0[i] = i + 33;
-					}
-					// Now we're defining "future" table.
-					for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-						tblDividersRt[i] = tblDividersR0[i];
-					break;
-				case 1:
-					// Now we're defining "future" table, but based on prime numbers.
-					for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-						tblDividersRt[i] = tblPrimes[i];
-					break;
-				case 2:
-					// Now we're defining "future" table, but based on perfect squares.
-					for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-						tblDividersRt[i] = tblSquares[i];
-					break;
-				case 3:
-					// Now we're defining "future" table, but based on Fibonacci sequence.
-					for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-						tblDividersRt[i] = tblFibonacci[i];
-					break;
-				case 4:
-					// Now we're defining "future" table, but based on triplet & 16ths.
-					for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-						tblDividersRt[i] = tblTripletSixteenths[i];
+			else {
+				// User tables: "Max Div" amount is highest divider of the table.
+				RKDUserTables &userTablesSet = userTables[userTablesIndex];
+				int userTable = tableSet - RKD_FIRST_USER_TABLESET;
+				maxDivAmount = userTablesSet.maxDiv[userTable];
+				rotationRows = &userTablesSet.rows[userTablesSet.rowFirst[userTable]];
+				rotationRowCount = userTablesSet.rowCount[userTable];
 			}
+			// Table rotation is armed for all channels.
+			engine.setTable(rotationRows, rotationRowCount, maxDivAmount, tableSet, rkxFactor);
 			// Clearing flag about table change "preparation".
 			bTableChange = false;
-			// Arming table rotation (required after table change).
-			bDoRotation  = true;
-			bDoRotationOnRisingEdge  = false;
 		}
 
 		tableSetPrev = tableSet;
+		rkxFactorPrev = rkxFactor;
 
-		// CV ROTATE analysis: is module receive ROTATE voltage?
-		if (inputs[ROTATE_INPUT].isConnected()) {
-			// CV ROTATE voltage must be between 0V to +5V (inclusive) - otherwise, voltage is clipped.
-			cvRotate = clamp(inputs[ROTATE_INPUT].getVoltage(), 0.0f, 5.0f);
-		}
-		else cvRotate = 0.0f; // Assuming 0V while ROTATE input port isn't wired.
-
-		// "cvRotateTblIndex" is a kind of index to dividers table.
-		switch (tableSet) {
-			case 0:
-				// Manufacturer table is also based on "Max-Div" amount (jumpers J3-J4, or Max Div switches setting on BRK panel).
-				cvRotateTblIndex = int(cvRotate / 5.0f * (float)(maxDivAmount));
-				if (cvRotateTblIndex >= maxDivAmount)
-					cvRotateTblIndex = maxDivAmount - 1; // Possible number of table rotations is based on Max Div amount!
-				break;
-			case 1:
-				// Prime is based on 18 possible values, meaning 11 possible "sliding windows" to get access to 8 (consecutive) prime numbers (one per output jack).
-				cvRotateTblIndex = int(cvRotate / 5.0f * 11.0f);
-				if (cvRotateTblIndex >= 11)
-					cvRotateTblIndex = 10;
-				break;
-			case 2:
-			case 4:
-				// "Perfect squares" and "Triplet & 16ths" are based on 8 possible values (one per output jack).
-				cvRotateTblIndex = int(cvRotate / 5.0f * 8.0f);
-				if (cvRotateTblIndex >= 8)
-					cvRotateTblIndex = 7;
-				break;
-			case 3:
-				// Fibonacci sequence is based on 8 possible values, 1 possible rotation (first), then 10 possible translations.
-				cvRotateTblIndex = int(cvRotate / 5.0f * 11.0f);
-				if (cvRotateTblIndex >= 11)
-					cvRotateTblIndex = 10;
-				break;
-		}
-
-		// If table index have changed (or rotation was previously set), rotation is required.
-		bDoRotation = bDoRotation || (cvRotateTblIndexPrevious != cvRotateTblIndex);
-
-		// Is table rotation required?
-		if (bDoRotation) {
-			// Clear "preparation" flag.
-			bDoRotation  = false;
-			// Table rotation is required. Set (arm) another/next flag, by this way, real rotation will occur on next CLK rising-edge.
-			bDoRotationOnRisingEdge  = true;
-			// Depending table set (Manufacturer, Prime numbers, Perfect squares, or Fibonacci sequence).
-			switch (tableSet) {
-				case 0:
-					// Manufacturer table.
-					if (jmprMaxDivRange16 && jmprMaxDivRange32 && jmprSpread) {
-						// Particular case when Max-Divide-Amount is 8 by jumpers/switches --AND-- Spread is On...
-						// In this special case, all ports will output standard "musical" divisions of 16ths & triplets.
-						// We're using "cell moves" (like a shorting routine will do).
-						// Firstly, duplicating base "R+0" table...
-						for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-							tblDividersRt[i] = tblDividersR0[i];
-						// ...then doing "j" moves (from bottom to top).
-						for (int j = 0; j < cvRotateTblIndex; j++) {
-							// Saving OUTPUT 1.
-							tblDividersRt[8] = tblDividersRt[OUTPUT_1];
-							tblDividersRt[OUTPUT_1] = tblDividersRt[OUTPUT_2];
-							tblDividersRt[OUTPUT_2] = tblDividersRt[OUTPUT_3];
-							tblDividersRt[OUTPUT_3] = tblDividersRt[OUTPUT_4];
-							tblDividersRt[OUTPUT_4] = tblDividersRt[OUTPUT_5];
-							tblDividersRt[OUTPUT_5] = tblDividersRt[OUTPUT_6];
-							tblDividersRt[OUTPUT_6] = tblDividersRt[OUTPUT_7];
-							tblDividersRt[OUTPUT_7] = tblDividersRt[OUTPUT_8];
-							// Previously saved OUTPUT 1 is restored to... OUTPUT 8!
-							tblDividersRt[OUTPUT_8] = tblDividersRt[8];
-						}
-					}
-					else {
-						// All other cases are standard shifting.
-						for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++) {
-							// Duplicating "R+0" reference table, then adding number of rotation(s).
-							tblDividersRt[i] = tblDividersR0[i] + cvRotateTblIndex;
-							if (tblDividersRt[i] > maxDivAmount) {
-								// Applying "modulo" if necessary!
-								tblDividersRt[i] = (tblDividersRt[i] % maxDivAmount);
-							}
-						}
-					}
-					break;
-				case 1:
-					// Prime numbers-based table.
-					for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-						tblDividersRt[i] = tblPrimes[i + cvRotateTblIndex];
-					break;
-				case 2:
-				case 4:
-					// "Perfect squares" or "Triplet & 16ths" based table.
-					// Firstly, duplicating perfect squares table...
-					for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-						if (tableSet == 2)
-						tblDividersRt[i] = tblSquares[i];
-						else tblDividersRt[i] = tblTripletSixteenths[i];
-					// ...then doing "j" moves (from bottom to top).
-					for (int j = 0; j < cvRotateTblIndex; j++) {
-						// Saving OUTPUT 1.
-						tblDividersRt[8] = tblDividersRt[OUTPUT_1];
-						tblDividersRt[OUTPUT_1] = tblDividersRt[OUTPUT_2];
-						tblDividersRt[OUTPUT_2] = tblDividersRt[OUTPUT_3];
-						tblDividersRt[OUTPUT_3] = tblDividersRt[OUTPUT_4];
-						tblDividersRt[OUTPUT_4] = tblDividersRt[OUTPUT_5];
-						tblDividersRt[OUTPUT_5] = tblDividersRt[OUTPUT_6];
-						tblDividersRt[OUTPUT_6] = tblDividersRt[OUTPUT_7];
-						tblDividersRt[OUTPUT_7] = tblDividersRt[OUTPUT_8];
-						// Previously saved OUTPUT 1 is restored to... OUTPUT 8!
-						tblDividersRt[OUTPUT_8] = tblDividersRt[8];
-					}
-					break;
-				case 3:
-					// Fibonacci-based table.
-					// Firstly, duplicating Fibonacci table.
-					if (cvRotateTblIndex < 2) {
-						// No rotation use 1, 2, 3, 5, 8, 13, 21, 34.
-						// First rotation uses 2, 3, 5, 8, 13, 21, 34, 55.
-						for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-							tblDividersRt[i] = tblFibonacci[i + cvRotateTblIndex];
-					}
-					else {
-						// Next rotations are based on 2, 3, 5, 8, 13, 21, 34, 55, then applying +R shift.
-						// On second and later rotation, then applying "+R" on all ports.
-						for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-							tblDividersRt[i] = tblFibonacci[i + 1] + cvRotateTblIndex - 1;
-					}
-			}
+		// RKX expander handling (right-side of RKD has priority). RKX at left-side is ignored if it's attached to another RKD (at its
+		// left-side, having priority for RKX).
+		if (rightExpander.module && (rightExpander.module->model == modelRKX))
+			rkxModule = rightExpander.module;
+			else if (leftExpander.module && (leftExpander.module->model == modelRKX) && !(leftExpander.module->leftExpander.module && (leftExpander.module->leftExpander.module->model == modelRKD)))
+				rkxModule = leftExpander.module;
+				else rkxModule = nullptr;
+		bool bRKXattached = (rkxModule && (rkxModule != rkxModulePrev));
+		rkxModulePrev = rkxModule;
+		// Auto-Reset cycle: given by CYCLE CV (RKX expander) while wired, otherwise by context-menu.
+		engine.autoResetCycle = autoResetCycle;
+		if (rkxModule) {
+			RKXCycleMessage *cycleMessage = &((RKDExpanderMessage*)((rkxModule == rightExpander.module) ? rightExpander.consumerMessage : leftExpander.consumerMessage))->rkx;
+			if (cycleMessage->bCycleCV)
+				engine.autoResetCycle = rkdAutoResetCycles[clamp((int)std::round(cycleMessage->cycleCV), 0, RKD_NUM_AUTORESET_CYCLES - 1)];
 		}
-
-		// By default assuming this step isn't a CLK rising edge.
-		bIsRisingEdge = false;
-		// By default assuming this step isn't a CLK falling edge.
-		bIsFallingEdge = false;
-
 		// Module is running (enabled) as long as its CLK input jack is wired.
 		bCLKisActive = inputs[CLK_INPUT].isConnected();
 		if (!bCLKisActive) {
-			// Module in timeout (idle) mode.
-			ModuleTimeOut();
-			// CLK isn't connected: display "--" in all segment-LED displays (using -1).
-			if (bDisplayNoDividers) {
-				strcpy(dispDiv1, "--");
-				strcpy(dispDiv2, "--");
-				strcpy(dispDiv3, "--");
-				strcpy(dispDiv4, "--");
-				strcpy(dispDiv5, "--");
-				strcpy(dispDiv6, "--");
-				strcpy(dispDiv7, "--");
-				strcpy(dispDiv8, "--");
-				bDisplayNoDividers = false;
-			}
+			// Module in timeout (idle) mode, for all channels used so far.
+			for (int c = 0; c < nChannels; c++)
+				ChannelTimeOut(c);
+			// Back to monophonic outputs.
+			nChannels = 1;
+			setOutputChannels();
 		}
 		else {
-			// CLK input port is wired.
-			// Increment step number.
-			currentStep++;
-			if ((currentStep % 32) == 0) {
-				// Update segment-LEDs to display the eight dividers alongside their jacks (done every 32 frames, to avoid CPU load).
-				// Based on "future" table!
-				snprintf(dispDiv1, sizeof(dispDiv1), "%2i", tblDividersRt[OUTPUT_1]);
-				snprintf(dispDiv2, sizeof(dispDiv2), "%2i", tblDividersRt[OUTPUT_2]);
-				snprintf(dispDiv3, sizeof(dispDiv3), "%2i", tblDividersRt[OUTPUT_3]);
-				snprintf(dispDiv4, sizeof(dispDiv4), "%2i", tblDividersRt[OUTPUT_4]);
-				snprintf(dispDiv5, sizeof(dispDiv5), "%2i", tblDividersRt[OUTPUT_5]);
-				snprintf(dispDiv6, sizeof(dispDiv6), "%2i", tblDividersRt[OUTPUT_6]);
-				snprintf(dispDiv7, sizeof(dispDiv7), "%2i", tblDividersRt[OUTPUT_7]);
-				snprintf(dispDiv8, sizeof(dispDiv8), "%2i", tblDividersRt[OUTPUT_8]);
-				// Rearm the "--" display, in case the CLK will be unwired later...
-				bDisplayNoDividers = true;
-			}
-			// Using Schmitt trigger (SchmittTrigger is provided by dsp/digital.hpp) to detect triggers on CLK input jack.
-			if (CLK_Port.process(rescale(inputs[CLK_INPUT].getVoltage(), 0.2f, 3.5f, 0.0f, 1.0f))) {
-				// It's a rising edge.
-				bIsRisingEdge = true;
-				// Disarm timeout flag.
-				bCLKTimeOut = false;
-				// CLK input is receiving a compliant trigger voltage (trigger on rising edge).
-				// If rotation was requested, it becomes effective on received rising edge. Set the new current dividers table.
-				if (bDoRotationOnRisingEdge) {
-					for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-						tblActiveDividers[i] = tblDividersRt[i];
-					// Define adaptative "Max Div" amount, but only for "Primes numbers" table!
-					// "Max Div" can be 32 or 64, depending highest divider.
-					if (tableSet == 1) {
-						if (tblActiveDividers[7] > 32)
-							maxDivAmount = 64;
-							else maxDivAmount = 32;
-					}
-					// Rotation was done.
-					bDoRotationOnRisingEdge  = false;
-				}
-				// Frequency of source CLK.
-				if (previousStep == 0) {
-					// Source CLK frequency is unknown.
-					bCLKFreqKnown = false;
-					expectedStep = 0;
-				}
-				else {
-					// But perhaps this rising edge comes too early (source frequency is increased).
-					if (bCLKFreqKnown) {
-						if (currentStep != expectedStep) {						
-							bCLKFreqKnown = false;
-							expectedStep = 0;
-							currentStep = 1;
-						}
-						else {
-							// Source CLK frequency is stable.
-							bCLKFreqKnown = true;
-							expectedStep = currentStep - previousStep + currentStep;
-						}
-					}
-					else {
-						// Source CLK frequency was unknow at previous rising edge, but for now it can be established on this (next) rising edge.
-						bCLKFreqKnown = true;
-						expectedStep = currentStep - previousStep + currentStep;
-					}
-				}
-				// Of course, on rising edgen the CLK signal is high!
-				bCLKisHigh = true;
-				// ...and this current step (on rising edge) becomes... previous step, for next rising edge detection!
-				previousStep = currentStep;
-			}
-			else {
-				// At this point it's not a rising edge (maybe incoming signal is already at high state, or low, or a falling edge).
-				// Is it a falling edge?
-				if (bCLKisHigh && (clamp(inputs[CLK_INPUT].getVoltage(), 0.0f, 15.0f) < 0.2f)) {
-					// At previous step it was high, but now is low, meaning this step is a falling edge.
-					bCLKisHigh = false; // Below 2V, disarm the flag to stop counting.
-					// It's a falling edge.
-					bIsFallingEdge = true;
-				}
-				// Also, be sure the CLK source frequency wasn't lower (slower signal).
-				if (expectedStep != 0) {
-					if (currentStep >= expectedStep) {
-						// CLK frequency is lower (slower), or... no more signal (kind of "timeout").
-						if (bCLKFreqKnown) {
-							// If the frequency was previously known, we give an extra delay prior timeout.
-							expectedStep = currentStep - previousStep + currentStep;  // Give an extra delay prior timeout.
-							bCLKFreqKnown = false;
-						}
-						else ModuleTimeOut(); // Timeout: module becomes "idle".
-					}
-				}
-			}
+			// CLK input port is wired: number of channels is given by CLK cable (ROTATE and RESET may be monophonic, then shared by all channels).
+			int nNewChannels = std::max(1, inputs[CLK_INPUT].getChannels());
+			// Channels no longer used are going into timeout (idle) mode.
+			for (int c = nNewChannels; c < nChannels; c++)
+				ChannelTimeOut(c);
+			nChannels = nNewChannels;
+			setOutputChannels();
+			// Proceeding all channels.
+			for (int c = 0; c < nChannels; c++)
+				processChannel(c);
 		}
 
-		// "CLK" white LED state.
-		lights[LED_CLK].setBrightness((bCLKisHigh ? 1.0f : 0.0f));
-		// Using Schmitt trigger (SchmittTrigger is provided by dsp/digital.hpp) to register incoming trigger signal on RESET jack (anytime).
-		if (!bRegisteredResetOnJack)
-			bRegisteredResetOnJack = RESET_Port.process(rescale(inputs[RESET_INPUT].getVoltage(), 0.2f, 3.5f, 0.0f, 1.0f));
-
-		// Registered RESET on jack becomes effective on next incoming rising edge.
-		if (bIsRisingEdge) {
-			// Clearing "Auto-Reset" flag.
-			bIsAutoReset = false;
-			// Is RESET jack was triggered?
-			bResetOnJack = bRegisteredResetOnJack;
-			bRegisteredResetOnJack = false;
-			// Global dividers counters reset for all output jacks, due to received pulse on "RESET" jack.
-			if (bResetOnJack) {
-				// Reset Schmitt trigger used by RESET input jack.
-				RESET_Port.reset();
-				// This will "force" disabling RESET LED afterglow, in order to lit orange LED.
-				ledResetAfterglow = 0;
-				// Reset dividers counters.
-				for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-					divCounters[i] = 0;
-				// Temporary inhibit Auto-Reset.
-				bAllowAutoReset = false;
-				// Restart Auto-Reset sequence (counter).
-				divCountersAutoReset = 0;
-			}		
-		}
-		else bResetOnJack = false;
+		// Newly attached RKX expander: all its output jacks are written (afterwards, only changed jacks are written).
+		if (bRKXattached)
+			for (int c = 0; c < nChannels; c++)
+				for (int i = 0; i < NUM_OUTPUTS; i++)
+					rkxModule->outputs[i].setVoltage(((engine.channels[c].outputStates & (1 << (NUM_OUTPUTS + i))) ? 5.0f : 0.0f), c);
 
-		// Determine initial pulsing state, only on early rising edge!
-		if (bIsEarlyRisingEdge)
-			for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
-				bJackIsFired[i] = !jmprCountingDown;
+		// LEDs and segment-LED displays (at UI rate).
+		if (lightDivider.process())
+			updateLightsAndDisplays(lightDivider.getDivision());
 
-		// Auto-reset and pulsing management (for each output jack).
-		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++) {
-			if (bIsRisingEdge) {
-				// On rising edge.
-				// Is the "Auto-Reset", for this current jack, must be applied first, or not?
-				// "Auto-Reset" may occurs only if "Auto-Reset" jumper/switch is On, not temporary disabled, and Auto-Reset counter is 0, and for certain dividers.
-				if ((jmprAutoReset) && (bAllowAutoReset) && (divCountersAutoReset == 0) && (((2 * maxDivAmount) % tblActiveDividers[i]) != 0)) {
-					divCounters[i] = 0;
-					bIsAutoReset = true;
-					bAutoResetLEDfired = true;
-				}
-				// Pulse generators.
-				if (jmprGate) {
-					// Gate modes.
-					if ((tblActiveDividers[i] % 2) == 0) {
-						// On all even dividers...
-						if (divCounters[i] % (tblActiveDividers[i] / 2) == 0)
-							pulseOutputJack(i, !bJackIsFired[i]); // Invert state of pulse.
-					}
-					else {
-						// On all odd dividers...
-						// /1 in (gate modes) must be considered differently, in fact like... trigger mode! (TBC).
-						if (tblActiveDividers[i] == 1)
-							pulseOutputJack(i, true); // Degraded" pulse while source frequency isn't stable.
-						else if ((divCounters[i] % tblActiveDividers[i]) == 0)
-							pulseOutputJack(i, !bJackIsFired[i]); // Invert state of pulse.
-					}
-				}
-				else {
-					// Trigger modes (default).
-					if (jmprCountingDown)
-						pulseOutputJack(i, (divCounters[i] % tblActiveDividers[i]) == 0); // Counting down mode.
-						else pulseOutputJack(i, ((divCounters[i] + 1) % tblActiveDividers[i]) == 0); // Counting up mode (default).
-				}
-				// Advances next divider counter for this jack.
-				// Increment divider counter...
-				divCounters[i]++;
-				// ...and restart to 0 when division value (for current jack) is reached (or over).
-				if (divCounters[i] >= tblActiveDividers[i])
-					divCounters[i] = 0;
-			}
-			else if (bIsFallingEdge) {
-				// On falling edge (only).
-				if (jmprGate) {
-					// Gate mode.
-					if ((tblActiveDividers[i] % 2) == 1) {
-						if (((divCounters[i] + ((tblActiveDividers[i] - 1) / 2)) % tblActiveDividers[i]) == 0)
-							pulseOutputJack(i, !bJackIsFired[i]); // Invert state of pulse.
-					}
-				}
-				else pulseOutputJack(i, false); // Trigger mode: always stop pulsing on falling edge (for any divider).
-			}
-		}
+	} // end of "process"...
 
-		// Advance "Auto-Reset" counter (global, on rising edges only).
-		if (bIsRisingEdge) {
-			// Increment "Auto-Reset" sequence counter...
-			divCountersAutoReset++;
-			// ...and restart to 0 when "2 x Max-Div" is reached.
-			if ((divCountersAutoReset % (2 * maxDivAmount)) == 0)
-				divCountersAutoReset = 0;
-			// Now next rising edge aren't first rising edge.
-			bIsEarlyRisingEdge = false;
-			// Allow next Auto-Reset events.
-			bAllowAutoReset = true;
-		}
-		else bResetOnJack = false;
+	// Number of channels of output jacks (RKD, and RKX expander if attached).
+	void setOutputChannels() {
+		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
+			outputs[i].setChannels(nChannels);
+		if (rkxModule)
+			for (int i = 0; i < NUM_OUTPUTS; i++)
+				rkxModule->outputs[i].setChannels(nChannels);
+	}
+
+	// LEDs and segment-LED displays update (reflecting first channel), called every "elapsedSteps" steps.
+	void updateLightsAndDisplays(int elapsedSteps) {
+		RKDChannel &ch = engine.channels[0];
+
+		// "CLK" white LED state (lit while CLK is high, or if a rising edge occured since previous update).
+		lights[LED_CLK].setBrightness(((ch.bCLKisHigh || bLedClkLatched) ? 1.0f : 0.0f));
+		bLedClkLatched = false;
+
+		// Output jacks LEDs (lit while output is high, or if output was fired since previous update).
+		uint32_t ledOutputs = ch.outputStates | ledOutputsLatched;
+		ledOutputsLatched = 0;
+		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
+			lights[LED_OUT_1 + i].setBrightness(((ledOutputs & (1 << i)) ? 1.0f : 0.0f));
+		// RKX expander LEDs (if attached).
+		if (rkxModule)
+			for (int i = 0; i < NUM_OUTPUTS; i++)
+				rkxModule->lights[i].setBrightnessSmooth(((ledOutputs & (1 << (NUM_OUTPUTS + i))) ? 1.0f : 0.0f), elapsedSteps / sampleRate);
 
 		// "RESET" small red LED management (having afterglow).
+		bool bResetOnJack = bLedResetOnJackLatched;
+		bLedResetOnJackLatched = false;
+		// This will "force" disabling RESET LED afterglow, in order to lit orange LED.
+		if (bResetOnJack)
+			ledResetAfterglow = 0;
 		if (ledResetAfterglow > 0) {
-			ledResetAfterglow--;
+			ledResetAfterglow -= elapsedSteps;
 		}
 		else {
-			if ((bIsAutoReset && bAutoResetLEDfired) || bResetOnJack || bCLKTimeOut) {
-				if (bCLKTimeOut) {
+			if ((ch.bIsAutoReset && ch.bAutoResetLEDfired) || bResetOnJack || ch.bCLKTimeOut) {
+				if (ch.bCLKTimeOut) {
 					// Highest priority LED.
 					// Setup counter for red LED afterglow.
 					ledResetAfterglow = round(sampleRate / 4);
@@ -793,7 +714,7 @@ struct RKD : Module {
 					lights[LED_RESET_RED].setBrightness(0.0f);
 					lights[LED_RESET_ORANGE].setBrightness(0.0f);
 					lights[LED_RESET_BLUE].setBrightness(1.0f);
-					bAutoResetLEDfired = false;
+					ch.bAutoResetLEDfired = false;
 				}
 			}
 			else {
@@ -804,10 +725,57 @@ struct RKD : Module {
 			}
 		}
 
-		// Update current rotation index to become "previous". This will be useful to detect possible "table rotation" on next step.
-		cvRotateTblIndexPrevious = cvRotateTblIndex;
+		// Segment-LED displays: publishing the eight dividers, based on "future" table (or "--" while CLK isn't connected).
+		uint64_t dividers = 0;
+		if (bCLKisActive)
+			for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
+				dividers |= (uint64_t)((uint8_t)((int8_t)(ch.tblDividersRt[i]))) << (8 * i);
+		displayDividers.store(dividers);
 
-	} // end of "process"...
+		// Cycle analysis: publishing active dividers (multipliers are restarting on each CLK pulse), counters and Auto-Reset cycle.
+		uint64_t activeDividers = 0;
+		uint64_t counters = 0;
+		uint32_t autoReset = 0;
+		if (bCLKisActive) {
+			for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++) {
+				activeDividers |= (uint64_t)(ch.tblActiveDividers[i] & 0xff) << (8 * i);
+				counters |= (uint64_t)(ch.divCounters[i] & 0xff) << (8 * i);
+			}
+			autoReset = (uint32_t)(ch.autoResetLength << 16) | (uint32_t)(ch.divCountersAutoReset);
+			if (jmprAutoReset)
+				autoReset |= 0x80000000;
+		}
+		cycleDividers.store(activeDividers);
+		cycleCounters.store(counters);
+		cycleAutoReset.store(autoReset);
+	}
+
+	// Clock, rotation, reset and dividers processing, for a given channel (CLK input jack is wired), by dividers engine.
+	void processChannel(int c) {
+		engine.process(c, inputs[CLK_INPUT].getVoltage(c), (inputs[ROTATE_INPUT].isConnected() ? inputs[ROTATE_INPUT].getPolyVoltage(c) : 0.0f), inputs[RESET_INPUT].getPolyVoltage(c));
+		writeOutputJacks(c);
+		// LEDs are reflecting first channel: CLK rising edge and RESET via jack are latched until next LEDs update.
+		if (c == 0) {
+			bLedClkLatched = bLedClkLatched || engine.channels[0].bIsRisingEdge;
+			bLedResetOnJackLatched = bLedResetOnJackLatched || engine.channels[0].bResetOnJack;
+		}
+	}
+
+	// Writing output jacks pulsed by dividers engine during last processed sample (RKD, and RKX expander if attached). Fired output
+	// jacks are latched for LEDs (first channel).
+	void writeOutputJacks(int c) {
+		RKDChannel &ch = engine.channels[c];
+		if (ch.changedJacks & 0xff)
+			for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
+				if (ch.changedJacks & (1 << i))
+					outputs[i].setVoltage(((ch.outputStates & (1 << i)) ? 5.0f : 0.0f), c);
+		if (rkxModule && (ch.changedJacks & 0xff00))
+			for (int i = 0; i < NUM_OUTPUTS; i++)
+				if (ch.changedJacks & (1 << (NUM_OUTPUTS + i)))
+					rkxModule->outputs[i].setVoltage(((ch.outputStates & (1 << (NUM_OUTPUTS + i))) ? 5.0f : 0.0f), c);
+		if (c == 0)
+			ledOutputsLatched |= ch.firedJacks;
+	}
 
 	// Persistence for extra datas via json functions (in particular setting defined via jumpers/switches, and table set).
 	// These extra datas are saved into .vcv files (including "autosave.vcv").
@@ -821,7 +789,34 @@ struct RKD : Module {
 		json_object_set_new(rootJ, "jmprMaxDivRange32", json_boolean(jmprMaxDivRange32)); // "Max-Div-Range 32" jumper/switch.
 		json_object_set_new(rootJ, "jmprSpread", json_boolean(jmprSpread)); // "Spread" jumper/switch.
 		json_object_set_new(rootJ, "jmprAutoReset", json_boolean(jmprAutoReset)); // "Auto-Reset" jumper/switch.
-		json_object_set_new(rootJ, "tableSet", json_integer(tableSet)); // Table set (0: Manufacturer, 1: Prime numbers, 2: Perfect squares, 3: Fibonacci sequence).
+		json_object_set_new(rootJ, "tableSet", json_integer(tableSet)); // Table set (0: Manufacturer, 1: Prime numbers, 2: Perfect squares, 3: Fibonacci sequence, 4: Triplet & 16ths, 5: Multipliers, from 8: user tables).
+		json_object_set_new(rootJ, "rkxFactor", json_integer(rkxFactor)); // RKX expander dividers factor.
+		json_object_set_new(rootJ, "rotateSlewTime", json_real(rotateSlewTime.load())); // ROTATE CV slew time.
+		json_object_set_new(rootJ, "clkTolerance", json_real(clkToleranceSetting.load())); // Clock period tracker: tolerance window.
+		json_object_set_new(rootJ, "clkTimeoutPeriods", json_integer(clkTimeoutPeriodsSetting.load())); // Clock period tracker: timeout (periods).
+		json_object_set_new(rootJ, "autoResetCycle", json_integer(autoResetCycle)); // Auto-Reset cycle (0: "2 x Max Div").
+		// Groove (swing and humanise per RKD output jack), and seed of humanise random sequence.
+		json_t *swingJ = json_array();
+		json_t *humaniseJ = json_array();
+		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++) {
+			json_array_append_new(swingJ, json_real(swingSetting[i].load()));
+			json_array_append_new(humaniseJ, json_real(humaniseSetting[i].load()));
+		}
+		json_object_set_new(rootJ, "swing", swingJ);
+		json_object_set_new(rootJ, "humanise", humaniseJ);
+		json_object_set_new(rootJ, "humaniseSeed", json_integer(humaniseSeedSetting.load()));
+		// Probability per RKD output jack, and seed of random sequence.
+		json_t *probabilityJ = json_array();
+		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++)
+			json_array_append_new(probabilityJ, json_real(probabilitySetting[i].load()));
+		json_object_set_new(rootJ, "probability", probabilityJ);
+		json_object_set_new(rootJ, "probabilitySeed", json_integer(probabilitySeedSetting.load()));
+		// Cycle analysis readout on displays.
+		json_object_set_new(rootJ, "cycleReadout", json_boolean(bCycleReadout));
+		// User tables are saved into patch (this way, patch doesn't depend on user tables file).
+		RKDUserTables &userTablesSet = userTables[userTablesActive.load()];
+		if (userTablesSet.count > 0)
+			json_object_set_new(rootJ, "userTables", userTablesSet.toJson());
 		return rootJ;
 	}
 
@@ -848,9 +843,87 @@ struct RKD : Module {
 		json_t *jmprAutoResetJ = json_object_get(rootJ, "jmprAutoReset");
 		if (jmprAutoResetJ)
 			jmprAutoReset = json_is_true(jmprAutoResetJ);
+		json_t *rkxFactorJ = json_object_get(rootJ, "rkxFactor");
+		if (rkxFactorJ) {
+			rkxFactor = json_integer_value(rkxFactorJ);
+			if ((rkxFactor < 1) || (rkxFactor > 4))
+				rkxFactor = 2; // Set to default factor if not compliant.
+		}
+		json_t *rotateSlewTimeJ = json_object_get(rootJ, "rotateSlewTime");
+		if (rotateSlewTimeJ) {
+			float slewTime = json_number_value(rotateSlewTimeJ);
+			if ((slewTime < 0.0f) || (slewTime > 1.0f))
+				slewTime = 0.0f; // No slew if not compliant.
+			setRotateSlew(slewTime);
+		}
+		json_t *clkToleranceJ = json_object_get(rootJ, "clkTolerance");
+		if (clkToleranceJ) {
+			engine.clkTolerance = json_number_value(clkToleranceJ);
+			if ((engine.clkTolerance < 0.0f) || (engine.clkTolerance > 0.5f))
+				engine.clkTolerance = 0.05f; // Set to default tolerance if not compliant.
+		}
+		json_t *clkTimeoutPeriodsJ = json_object_get(rootJ, "clkTimeoutPeriods");
+		if (clkTimeoutPeriodsJ) {
+			engine.clkTimeoutPeriods = json_integer_value(clkTimeoutPeriodsJ);
+			if ((engine.clkTimeoutPeriods < 1) || (engine.clkTimeoutPeriods > 16))
+				engine.clkTimeoutPeriods = 2; // Set to default timeout if not compliant.
+		}
+		getClockSettings();
+		json_t *autoResetCycleJ = json_object_get(rootJ, "autoResetCycle");
+		if (autoResetCycleJ) {
+			autoResetCycle = json_integer_value(autoResetCycleJ);
+			if (std::find(rkdAutoResetCycles, rkdAutoResetCycles + RKD_NUM_AUTORESET_CYCLES, autoResetCycle) == rkdAutoResetCycles + RKD_NUM_AUTORESET_CYCLES)
+				autoResetCycle = 0; // Set to "2 x Max Div" if not compliant.
+		}
+		json_t *swingJ = json_object_get(rootJ, "swing");
+		json_t *humaniseJ = json_object_get(rootJ, "humanise");
+		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++) {
+			json_t *swingValueJ = json_array_get(swingJ, i);
+			if (swingValueJ) {
+				engine.swing[i] = json_number_value(swingValueJ);
+				if ((engine.swing[i] < 0.5f) || (engine.swing[i] > 0.75f))
+					engine.swing[i] = 0.5f; // No swing if not compliant.
+			}
+			json_t *humaniseValueJ = json_array_get(humaniseJ, i);
+			if (humaniseValueJ) {
+				engine.humanise[i] = json_number_value(humaniseValueJ);
+				if ((engine.humanise[i] < 0.0f) || (engine.humanise[i] > 0.1f))
+					engine.humanise[i] = 0.0f; // No humanise if not compliant.
+			}
+		}
+		json_t *humaniseSeedJ = json_object_get(rootJ, "humaniseSeed");
+		if (humaniseSeedJ)
+			engine.setHumaniseSeed((uint32_t)json_integer_value(humaniseSeedJ));
+		engine.setGroove();
+		getGrooveSettings();
+		json_t *probabilityJ = json_object_get(rootJ, "probability");
+		for (int i = OUTPUT_1; i < NUM_OUTPUTS; i++) {
+			json_t *probabilityValueJ = json_array_get(probabilityJ, i);
+			if (probabilityValueJ) {
+				engine.probability[i] = json_number_value(probabilityValueJ);
+				if ((engine.probability[i] < 0.0f) || (engine.probability[i] > 1.0f))
+					engine.probability[i] = 1.0f; // Every pulse is fired if not compliant.
+			}
+		}
+		json_t *probabilitySeedJ = json_object_get(rootJ, "probabilitySeed");
+		if (probabilitySeedJ)
+			engine.probabilitySeed = (uint32_t)json_integer_value(probabilitySeedJ);
+		for (int c = 0; c < PORT_MAX_CHANNELS; c++)
+			engine.channels[c].probabilityState = engine.getProbabilityState(c); // Restart probability random sequence (reproducible render).
+		engine.setProbability();
+		getProbabilitySettings();
+		json_t *cycleReadoutJ = json_object_get(rootJ, "cycleReadout");
+		if (cycleReadoutJ)
+			bCycleReadout = json_is_true(cycleReadoutJ);
+		json_t *userTablesJ = json_object_get(rootJ, "userTables");
+		if (userTablesJ)
+			loadUserTables(userTablesJ, true); // User tables from patch take over user tables file.
 		json_t *tableSetJ = json_object_get(rootJ, "tableSet");
-		if (tableSetJ)
+		if (tableSetJ) {
 			tableSet = json_integer_value(tableSetJ);
+			if (!isTableSetAvailable(tableSet))
+				tableSet = 0; // Set to manufacturer table if not compliant.
+		}
 	}
 
 }; // End of module (object) definition.
@@ -876,14 +949,35 @@ struct RKD_Displays : TransparentWidget {
 			Vec textPos = Vec(16, box.size.y - 150);
 			if (module) {
 				if (!module->isBypassed()) {
-					nvgText(args.vg, textPos.x, textPos.y + 29.5, module->dispDiv1, NULL);
-					nvgText(args.vg, textPos.x, textPos.y + 59.5, module->dispDiv2, NULL);
-					nvgText(args.vg, textPos.x, textPos.y + 89.5, module->dispDiv3, NULL);
-					nvgText(args.vg, textPos.x, textPos.y + 119.5, module->dispDiv4, NULL);
-					nvgText(args.vg, textPos.x, textPos.y + 149.5, module->dispDiv5, NULL);
-					nvgText(args.vg, textPos.x, textPos.y + 179.5, module->dispDiv6, NULL);
-					nvgText(args.vg, textPos.x, textPos.y + 209.5, module->dispDiv7, NULL);
-					nvgText(args.vg, textPos.x, textPos.y + 239.5, module->dispDiv8, NULL);
+					if (module->bCycleReadout) {
+						// Cycle analysis: pattern length (four upper displays) then next coincidence (four lower displays), upto 8 digits.
+						RKDCycleAnalysis analysis = module->getCycleAnalysis();
+						uint64_t values[2] = {analysis.length, analysis.nextCoincidence};
+						for (int v = 0; v < 2; v++) {
+							char digits[9];
+							if ((values[v] == 0) || (values[v] > 99999999))
+								strcpy(digits, "--------"); // Unknown, never, or too long (see context-menu).
+								else snprintf(digits, sizeof(digits), "%8llu", (unsigned long long)values[v]);
+							for (int i = 0; i < 4; i++) {
+								char dispDigits[3] = {digits[2 * i], digits[2 * i + 1], 0};
+								nvgText(args.vg, textPos.x, textPos.y + 29.5 + 30 * (4 * v + i), dispDigits, NULL);
+							}
+						}
+					}
+					else {
+						// Dividers (snapshot published by audio thread).
+						uint64_t dividers = module->displayDividers.load();
+						char dispDiv[4];
+						for (int i = 0; i < 8; i++) {
+							int divider = (int)((int8_t)((dividers >> (8 * i)) & 0xff));
+							if (divider == 0)
+								strcpy(dispDiv, "--");
+								else if (divider < 0)
+									snprintf(dispDiv, sizeof(dispDiv), "x%i", -divider); // Multiplier.
+									else snprintf(dispDiv, sizeof(dispDiv), "%2i", divider);
+							nvgText(args.vg, textPos.x, textPos.y + 29.5 + 30 * i, dispDiv, NULL);
+						}
+					}
 				}
 			}
 			else {
@@ -939,6 +1033,28 @@ struct RKDTripletSixteenthsItem : MenuItem {
 	}
 };
 
+struct RKDMultipliersItem : MenuItem {
+	RKD *module;
+	void onAction(const event::Action &e) override {
+		module->tableSet = 5; // Table: Multipliers.
+	}
+};
+
+struct RKDUserTableItem : MenuItem {
+	RKD *module;
+	int userTableSet;
+	void onAction(const event::Action &e) override {
+		module->tableSet = userTableSet; // Table: user table.
+	}
+};
+
+struct RKDReloadUserTablesItem : MenuItem {
+	RKD *module;
+	void onAction(const event::Action &e) override {
+		module->bUserTablesReloadPending = true; // Reload user tables file (as soon as possible).
+	}
+};
+
 struct RKDSubMenuItems : MenuItem {
 	RKD *module;
 	Menu *createChildMenu() override {
@@ -974,6 +1090,347 @@ struct RKDSubMenuItems : MenuItem {
 		rkdtripletsixteenthsitem->module = module;
 		menu->addChild(rkdtripletsixteenthsitem);
 
+		RKDMultipliersItem *rkdmultipliersitem = new RKDMultipliersItem;
+		rkdmultipliersitem->text = "Multipliers";
+		rkdmultipliersitem->rightText = CHECKMARK(module->tableSet == 5);
+		rkdmultipliersitem->module = module;
+		menu->addChild(rkdmultipliersitem);
+
+		// User tables.
+		menu->addChild(new MenuSeparator);
+		menu->addChild(createMenuLabel("User tables"));
+		RKDUserTables &userTablesSet = module->userTables[module->userTablesActive.load()];
+		for (int t = 0; t < userTablesSet.count; t++) {
+			RKDUserTableItem *rkdusertableitem = new RKDUserTableItem;
+			rkdusertableitem->text = userTablesSet.names[t];
+			rkdusertableitem->rightText = CHECKMARK(module->tableSet == RKD_FIRST_USER_TABLESET + t);
+			rkdusertableitem->module = module;
+			rkdusertableitem->userTableSet = RKD_FIRST_USER_TABLESET + t;
+			menu->addChild(rkdusertableitem);
+		}
+
+		RKDReloadUserTablesItem *rkdreloadusertablesitem = new RKDReloadUserTablesItem;
+		rkdreloadusertablesitem->text = "Reload user tables file";
+		if (module->bUserTablesReloadPending)
+			rkdreloadusertablesitem->rightText = "pending...";
+		rkdreloadusertablesitem->module = module;
+		menu->addChild(rkdreloadusertablesitem);
+
+		return menu;
+	}
+};
+
+struct RKDRKXFactorItem : MenuItem {
+	RKD *module;
+	int rkxFactor;
+	void onAction(const event::Action &e) override {
+		module->rkxFactor = rkxFactor; // RKX expander dividers factor.
+	}
+};
+
+struct RKDRKXSubMenuItems : MenuItem {
+	RKD *module;
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+		for (int f = 1; f <= 4; f++) {
+			RKDRKXFactorItem *rkdrkxfactoritem = new RKDRKXFactorItem;
+			rkdrkxfactoritem->text = "RKD dividers x" + std::to_string(f);
+			rkdrkxfactoritem->rightText = CHECKMARK(module->rkxFactor == f);
+			rkdrkxfactoritem->module = module;
+			rkdrkxfactoritem->rkxFactor = f;
+			menu->addChild(rkdrkxfactoritem);
+		}
+		return menu;
+	}
+};
+
+struct RKDClkToleranceItem : MenuItem {
+	RKD *module;
+	float clkTolerance;
+	void onAction(const event::Action &e) override {
+		module->clkToleranceSetting.store(clkTolerance); // Clock period tracker: tolerance window.
+		module->bClockSettingChange.store(true);
+	}
+};
+
+struct RKDClkTimeoutItem : MenuItem {
+	RKD *module;
+	int clkTimeoutPeriods;
+	void onAction(const event::Action &e) override {
+		module->clkTimeoutPeriodsSetting.store(clkTimeoutPeriods); // Clock period tracker: timeout.
+		module->bClockSettingChange.store(true);
+	}
+};
+
+struct RKDClockSubMenuItems : MenuItem {
+	RKD *module;
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+		const int tblTolerances[4] = {1, 5, 10, 25};
+		const int tblTimeouts[4] = {2, 3, 4, 8};
+		menu->addChild(createMenuLabel("Tolerance (jitter)"));
+		for (int t = 0; t < 4; t++) {
+			RKDClkToleranceItem *rkdclktoleranceitem = new RKDClkToleranceItem;
+			rkdclktoleranceitem->text = std::to_string(tblTolerances[t]) + "%";
+			rkdclktoleranceitem->rightText = CHECKMARK(std::round(module->clkToleranceSetting.load() * 100.0f) == tblTolerances[t]);
+			rkdclktoleranceitem->module = module;
+			rkdclktoleranceitem->clkTolerance = tblTolerances[t] / 100.0f;
+			menu->addChild(rkdclktoleranceitem);
+		}
+		menu->addChild(new MenuSeparator);
+		menu->addChild(createMenuLabel("Timeout"));
+		for (int t = 0; t < 4; t++) {
+			RKDClkTimeoutItem *rkdclktimeoutitem = new RKDClkTimeoutItem;
+			rkdclktimeoutitem->text = std::to_string(tblTimeouts[t]) + " periods";
+			rkdclktimeoutitem->rightText = CHECKMARK(module->clkTimeoutPeriodsSetting.load() == tblTimeouts[t]);
+			rkdclktimeoutitem->module = module;
+			rkdclktimeoutitem->clkTimeoutPeriods = tblTimeouts[t];
+			menu->addChild(rkdclktimeoutitem);
+		}
+		return menu;
+	}
+};
+
+struct RKDRotateSlewItem : MenuItem {
+	RKD *module;
+	float rotateSlewTime;
+	void onAction(const event::Action &e) override {
+		module->setRotateSlew(rotateSlewTime); // ROTATE CV slew time.
+	}
+};
+
+struct RKDRotateSlewSubMenuItems : MenuItem {
+	RKD *module;
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+		const int tblSlewTimes[4] = {0, 1, 5, 20};
+		for (int t = 0; t < 4; t++) {
+			RKDRotateSlewItem *rkdrotateslewitem = new RKDRotateSlewItem;
+			rkdrotateslewitem->text = (tblSlewTimes[t] == 0) ? "Off" : (std::to_string(tblSlewTimes[t]) + " ms");
+			rkdrotateslewitem->rightText = CHECKMARK(std::round(module->rotateSlewTime.load() * 1000.0f) == tblSlewTimes[t]);
+			rkdrotateslewitem->module = module;
+			rkdrotateslewitem->rotateSlewTime = tblSlewTimes[t] / 1000.0f;
+			menu->addChild(rkdrotateslewitem);
+		}
+		return menu;
+	}
+};
+
+struct RKDAutoResetCycleItem : MenuItem {
+	RKD *module;
+	int autoResetCycle;
+	void onAction(const event::Action &e) override {
+		module->autoResetCycle = autoResetCycle; // Auto-Reset cycle.
+	}
+};
+
+struct RKDAutoResetSubMenuItems : MenuItem {
+	RKD *module;
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+		for (int r = 0; r < RKD_NUM_AUTORESET_CYCLES; r++) {
+			RKDAutoResetCycleItem *rkdautoresetcycleitem = new RKDAutoResetCycleItem;
+			rkdautoresetcycleitem->text = (rkdAutoResetCycles[r] == 0) ? "2 x Max Div (factory)" : ("Every " + std::to_string(rkdAutoResetCycles[r]) + " clocks");
+			rkdautoresetcycleitem->rightText = CHECKMARK(module->autoResetCycle == rkdAutoResetCycles[r]);
+			rkdautoresetcycleitem->module = module;
+			rkdautoresetcycleitem->autoResetCycle = rkdAutoResetCycles[r];
+			menu->addChild(rkdautoresetcycleitem);
+		}
+		return menu;
+	}
+};
+
+// Names of RKD output jacks (groove submenus).
+static const char *rkdOutputNames[8] = {"1st output", "2nd output", "3rd output", "4th output", "5th output", "6th output", "7th output", "8th output"};
+
+struct RKDSwingItem : MenuItem {
+	RKD *module;
+	int output;
+	float swing;
+	void onAction(const event::Action &e) override {
+		module->swingSetting[output].store(swing); // Swing of given output jack.
+		module->bGrooveSettingChange.store(true);
+	}
+};
+
+struct RKDSwingOutputItems : MenuItem {
+	RKD *module;
+	int output;
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+		const int tblSwings[7] = {50, 54, 58, 62, 66, 71, 75};
+		for (int s = 0; s < 7; s++) {
+			RKDSwingItem *rkdswingitem = new RKDSwingItem;
+			rkdswingitem->text = (tblSwings[s] == 50) ? "Off (50%)" : (std::to_string(tblSwings[s]) + "%");
+			rkdswingitem->rightText = CHECKMARK(std::round(module->swingSetting[output].load() * 100.0f) == tblSwings[s]);
+			rkdswingitem->module = module;
+			rkdswingitem->output = output;
+			rkdswingitem->swing = tblSwings[s] / 100.0f;
+			menu->addChild(rkdswingitem);
+		}
+		return menu;
+	}
+};
+
+struct RKDSwingSubMenuItems : MenuItem {
+	RKD *module;
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+		for (int i = 0; i < 8; i++) {
+			RKDSwingOutputItems *rkdswingoutputitems = new RKDSwingOutputItems;
+			rkdswingoutputitems->text = rkdOutputNames[i];
+			rkdswingoutputitems->rightText = std::to_string((int)std::round(module->swingSetting[i].load() * 100.0f)) + "% " + RIGHT_ARROW;
+			rkdswingoutputitems->module = module;
+			rkdswingoutputitems->output = i;
+			menu->addChild(rkdswingoutputitems);
+		}
+		return menu;
+	}
+};
+
+struct RKDHumaniseItem : MenuItem {
+	RKD *module;
+	int output;
+	float humanise;
+	void onAction(const event::Action &e) override {
+		module->humaniseSetting[output].store(humanise); // Humanise of given output jack.
+		module->bGrooveSettingChange.store(true);
+	}
+};
+
+struct RKDHumaniseOutputItems : MenuItem {
+	RKD *module;
+	int output;
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+		const int tblHumanises[5] = {0, 1, 2, 5, 10};
+		for (int h = 0; h < 5; h++) {
+			RKDHumaniseItem *rkdhumaniseitem = new RKDHumaniseItem;
+			rkdhumaniseitem->text = (tblHumanises[h] == 0) ? "Off" : ("Up to " + std::to_string(tblHumanises[h]) + "% of period");
+			rkdhumaniseitem->rightText = CHECKMARK(std::round(module->humaniseSetting[output].load() * 100.0f) == tblHumanises[h]);
+			rkdhumaniseitem->module = module;
+			rkdhumaniseitem->output = output;
+			rkdhumaniseitem->humanise = tblHumanises[h] / 100.0f;
+			menu->addChild(rkdhumaniseitem);
+		}
+		return menu;
+	}
+};
+
+struct RKDHumaniseSeedItem : MenuItem {
+	RKD *module;
+	void onAction(const event::Action &e) override {
+		module->humaniseSeedSetting.store(random::u32()); // New humanise random sequence.
+		module->bGrooveSettingChange.store(true);
+	}
+};
+
+struct RKDHumaniseSubMenuItems : MenuItem {
+	RKD *module;
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+		for (int i = 0; i < 8; i++) {
+			RKDHumaniseOutputItems *rkdhumaniseoutputitems = new RKDHumaniseOutputItems;
+			rkdhumaniseoutputitems->text = rkdOutputNames[i];
+			rkdhumaniseoutputitems->rightText = std::to_string((int)std::round(module->humaniseSetting[i].load() * 100.0f)) + "% " + RIGHT_ARROW;
+			rkdhumaniseoutputitems->module = module;
+			rkdhumaniseoutputitems->output = i;
+			menu->addChild(rkdhumaniseoutputitems);
+		}
+		menu->addChild(new MenuSeparator);
+		RKDHumaniseSeedItem *rkdhumaniseseeditem = new RKDHumaniseSeedItem;
+		rkdhumaniseseeditem->text = "New random sequence (seed)";
+		rkdhumaniseseeditem->module = module;
+		menu->addChild(rkdhumaniseseeditem);
+		return menu;
+	}
+};
+
+struct RKDProbabilityItem : MenuItem {
+	RKD *module;
+	int output;
+	float probability;
+	void onAction(const event::Action &e) override {
+		module->probabilitySetting[output].store(probability); // Probability of given output jack.
+		module->bProbabilitySettingChange.store(true);
+	}
+};
+
+struct RKDProbabilityOutputItems : MenuItem {
+	RKD *module;
+	int output;
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+		const int tblProbabilities[7] = {100, 90, 75, 50, 33, 25, 10};
+		for (int p = 0; p < 7; p++) {
+			RKDProbabilityItem *rkdprobabilityitem = new RKDProbabilityItem;
+			rkdprobabilityitem->text = std::to_string(tblProbabilities[p]) + "%";
+			rkdprobabilityitem->rightText = CHECKMARK(std::round(module->probabilitySetting[output].load() * 100.0f) == tblProbabilities[p]);
+			rkdprobabilityitem->module = module;
+			rkdprobabilityitem->output = output;
+			rkdprobabilityitem->probability = tblProbabilities[p] / 100.0f;
+			menu->addChild(rkdprobabilityitem);
+		}
+		return menu;
+	}
+};
+
+struct RKDProbabilitySeedItem : MenuItem {
+	RKD *module;
+	void onAction(const event::Action &e) override {
+		module->probabilitySeedSetting.store(random::u32()); // New probability random sequence (restarted on next timeout).
+		module->bProbabilitySettingChange.store(true);
+	}
+};
+
+struct RKDProbabilitySubMenuItems : MenuItem {
+	RKD *module;
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+		for (int i = 0; i < 8; i++) {
+			RKDProbabilityOutputItems *rkdprobabilityoutputitems = new RKDProbabilityOutputItems;
+			rkdprobabilityoutputitems->text = rkdOutputNames[i];
+			rkdprobabilityoutputitems->rightText = std::to_string((int)std::round(module->probabilitySetting[i].load() * 100.0f)) + "% " + RIGHT_ARROW;
+			rkdprobabilityoutputitems->module = module;
+			rkdprobabilityoutputitems->output = i;
+			menu->addChild(rkdprobabilityoutputitems);
+		}
+		menu->addChild(new MenuSeparator);
+		RKDProbabilitySeedItem *rkdprobabilityseeditem = new RKDProbabilitySeedItem;
+		rkdprobabilityseeditem->text = "New random sequence (seed)";
+		rkdprobabilityseeditem->module = module;
+		menu->addChild(rkdprobabilityseeditem);
+		return menu;
+	}
+};
+
+struct RKDCycleReadoutItem : MenuItem {
+	RKD *module;
+	void onAction(const event::Action &e) override {
+		module->bCycleReadout = !module->bCycleReadout; // Displays are showing cycle analysis (or dividers).
+	}
+};
+
+struct RKDCycleSubMenuItems : MenuItem {
+	RKD *module;
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+		// Latest cycle analysis (from first channel).
+		RKDCycleAnalysis analysis = module->getCycleAnalysis();
+		if (analysis.lcm == 0)
+			menu->addChild(createMenuLabel("CLK isn't connected"));
+			else {
+				menu->addChild(createMenuLabel("Pattern length: " + std::to_string(analysis.length) + " clocks"));
+				if (analysis.length != analysis.lcm)
+					menu->addChild(createMenuLabel("Full cycle: " + std::to_string(analysis.lcm) + " clocks (shortened by Auto-Reset)"));
+				if (analysis.nextCoincidence == 0)
+					menu->addChild(createMenuLabel("Next coincidence: never (until reset)"));
+					else menu->addChild(createMenuLabel("Next coincidence: in " + std::to_string(analysis.nextCoincidence) + " clocks"));
+			}
+		menu->addChild(new MenuSeparator);
+		RKDCycleReadoutItem *rkdcyclereadoutitem = createMenuItem<RKDCycleReadoutItem>("Show on displays", CHECKMARK(module->bCycleReadout));
+		rkdcyclereadoutitem->module = module;
+		menu->addChild(rkdcyclereadoutitem);
 		return menu;
 	}
 };
@@ -1101,6 +1558,10 @@ struct RKDWidget : ModuleWidget {
 	void step() override {
 		RKD *module = dynamic_cast<RKD*>(this->module);
 		if (module) {
+			// Pending reload of user tables file (context-menu).
+			module->processUserTablesReload();
+			// Cycle analysis (only if snapshot has changed).
+			module->updateCycleAnalysis();
 			// Hide screws while PCB is visible.
 			topScrewSilver->visible = !module->bViewPCB;
 			bottomScrewSilver->visible = !module->bViewPCB;
@@ -1151,6 +1612,54 @@ struct RKDWidget : ModuleWidget {
 		rkdsubmenuitems->rightText = RIGHT_ARROW;
 		rkdsubmenuitems->module = module;
 		menu->addChild(rkdsubmenuitems);
+
+		RKDCycleSubMenuItems *rkdcyclesubmenuitems = new RKDCycleSubMenuItems;
+		rkdcyclesubmenuitems->text = "Cycle analysis";
+		rkdcyclesubmenuitems->rightText = RIGHT_ARROW;
+		rkdcyclesubmenuitems->module = module;
+		menu->addChild(rkdcyclesubmenuitems);
+
+		RKDRotateSlewSubMenuItems *rkdrotateslewsubmenuitems = new RKDRotateSlewSubMenuItems;
+		rkdrotateslewsubmenuitems->text = "ROTATE CV slew";
+		rkdrotateslewsubmenuitems->rightText = RIGHT_ARROW;
+		rkdrotateslewsubmenuitems->module = module;
+		menu->addChild(rkdrotateslewsubmenuitems);
+
+		RKDClockSubMenuItems *rkdclocksubmenuitems = new RKDClockSubMenuItems;
+		rkdclocksubmenuitems->text = "Clock tracking";
+		rkdclocksubmenuitems->rightText = RIGHT_ARROW;
+		rkdclocksubmenuitems->module = module;
+		menu->addChild(rkdclocksubmenuitems);
+
+		RKDAutoResetSubMenuItems *rkdautoresetsubmenuitems = new RKDAutoResetSubMenuItems;
+		rkdautoresetsubmenuitems->text = "Auto-Reset cycle";
+		rkdautoresetsubmenuitems->rightText = RIGHT_ARROW;
+		rkdautoresetsubmenuitems->module = module;
+		menu->addChild(rkdautoresetsubmenuitems);
+
+		RKDSwingSubMenuItems *rkdswingsubmenuitems = new RKDSwingSubMenuItems;
+		rkdswingsubmenuitems->text = "Swing";
+		rkdswingsubmenuitems->rightText = RIGHT_ARROW;
+		rkdswingsubmenuitems->module = module;
+		menu->addChild(rkdswingsubmenuitems);
+
+		RKDHumaniseSubMenuItems *rkdhumanisesubmenuitems = new RKDHumaniseSubMenuItems;
+		rkdhumanisesubmenuitems->text = "Humanise";
+		rkdhumanisesubmenuitems->rightText = RIGHT_ARROW;
+		rkdhumanisesubmenuitems->module = module;
+		menu->addChild(rkdhumanisesubmenuitems);
+
+		RKDProbabilitySubMenuItems *rkdprobabilitysubmenuitems = new RKDProbabilitySubMenuItems;
+		rkdprobabilitysubmenuitems->text = "Probability";
+		rkdprobabilitysubmenuitems->rightText = RIGHT_ARROW;
+		rkdprobabilitysubmenuitems->module = module;
+		menu->addChild(rkdprobabilitysubmenuitems);
+
+		RKDRKXSubMenuItems *rkdrkxsubmenuitems = new RKDRKXSubMenuItems;
+		rkdrkxsubmenuitems->text = "RKX expander dividers";
+		rkdrkxsubmenuitems->rightText = RIGHT_ARROW;
+		rkdrkxsubmenuitems->module = module;
+		menu->addChild(rkdrkxsubmenuitems);
 	}
 
 };
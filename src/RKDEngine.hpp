@@ -0,0 +1,1179 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+////// RKDEngine.hpp                                                                             //////
+////// RKD dividers engine: clock tracking, rotations, resets, dividers, multipliers, groove,    //////
+////// probability... without any dependency to Rack module (no input/output port, no light).    //////
+////// Used by RKD module (one sample in, one sample out, per channel). Only depends on standard //////
+////// library and SSE2 intrinsics (own Schmitt trigger and 4-lane vector), so it can be built   //////
+////// outside Rack (eg offline harness).                                                        //////
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+// SSE2 intrinsics (same as Rack SDK SIMD types: on ARM, SIMDe is translating them to NEON).
+#if defined(__ARM_NEON)
+	#ifndef SIMDE_ENABLE_NATIVE_ALIASES
+		#define SIMDE_ENABLE_NATIVE_ALIASES
+	#endif
+	#include <simde/x86/sse2.h>
+#else
+	#include <emmintrin.h>
+#endif
+
+// Number of RKD output jacks (each output jack has an extra lane for RKX expander).
+#define RKD_NUM_OUTPUTS 8
+// Maximum number of polyphonic channels (same as Rack PORT_MAX_CHANNELS).
+#define RKD_NUM_CHANNELS 16
+
+// Number of possible table sets (0: Manufacturer, 1: Prime numbers, 2: Perfect squares, 3: Fibonacci sequence, 4: Triplet & 16ths,
+// 5: Multipliers).
+#define RKD_NUM_TABLESETS 6
+// Number of possible jumpers/switches combinations concerning tables (Max-Div-Range 16, Max-Div-Range 32, Spread).
+#define RKD_NUM_JUMPERS_COMBOS 8
+// Total of precomputed rows: Manufacturer (16 + 8 + 16 + 16 + 32 + 32 + 64 + 64), Primes (11), Squares (8), Fibonacci (11), Triplet & 16ths (8),
+// Multipliers (8).
+#define RKD_NUM_ROTATION_ROWS 294
+// Table entries from -9 to -2 are multipliers (x9 to x2), instead of dividers.
+#define RKD_MAX_MULTIPLIER 9
+
+// Precomputed rotation tables: every dividers row (eight dividers, one per output jack), for every table set,
+// every jumpers/switches combination and every rotation index, are built once (when plugin is loaded).
+// By this way, a rotation (even driven by audio-rate ROTATE CV) is just a row selection, no more shifting loops or modulo.
+struct RKDRotationTables {
+	// Rows of dividers (all dividers are between 1 and 64, multipliers between -9 and -2, so a signed byte is enough).
+	int8_t rows[RKD_NUM_ROTATION_ROWS][8];
+	// First row (index into "rows"), per table set and per jumpers/switches combination (jumpers only matter for manufacturer table).
+	int rowFirst[RKD_NUM_TABLESETS][RKD_NUM_JUMPERS_COMBOS];
+	// Number of possible rotations, per table set and per jumpers/switches combination.
+	int rowCount[RKD_NUM_TABLESETS][RKD_NUM_JUMPERS_COMBOS];
+
+	RKDRotationTables() {
+		// Base tables (R+0) used to build all rows.
+		const int tblPrimes[18] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61};
+		const int tblSquares[8] = {1, 4, 9, 16, 25, 36, 49, 64};
+		const int tblFibonacci[9] = {1, 2, 3, 5, 8, 13, 21, 34, 55};
+		const int tblTripletSixteenths[8] = {1, 2, 3, 4, 8, 16, 32, 64};
+		const int tblMusicalSpread[8] = {1, 2, 3, 4, 6, 8, 12, 16};
+		const int tblMultipliers[8] = {-4, -3, -2, 1, 2, 3, 4, 8};
+		int nRow = 0;
+		// Manufacturer table: one group of rows per jumpers/switches combination.
+		for (int jc = 0; jc < RKD_NUM_JUMPERS_COMBOS; jc++) {
+			bool bMaxDivRange16 = (jc & 4) != 0;
+			bool bMaxDivRange32 = (jc & 2) != 0;
+			bool bSpread = (jc & 1) != 0;
+			int maxDiv = getManufacturerMaxDiv(bMaxDivRange16, bMaxDivRange32, bSpread);
+			rowFirst[0][jc] = nRow;
+			rowCount[0][jc] = maxDiv; // Possible number of table rotations is based on Max Div amount!
+			for (int r = 0; r < maxDiv; r++) {
+				for (int i = 0; i < 8; i++) {
+					if (bMaxDivRange16 && bMaxDivRange32 && bSpread) {
+						// Special case of "musical" divisions (triplets, 16ths), using "cell moves" (from bottom to top).
+						rows[nRow][i] = tblMusicalSpread[(i + r) % 8];
+					}
+					else {
+						// All other cases are standard shifting, from "R+0" reference table, then adding number of rotation(s).
+						int divR0;
+						if (bMaxDivRange16 && bMaxDivRange32)
+							divR0 = i + 1;
+							else if (bMaxDivRange16 && bSpread)
+								divR0 = 2 * i + 2;
+								else if (bMaxDivRange16)
+									divR0 = i + 9;
+									else if (bMaxDivRange32 && bSpread)
+										divR0 = 4 * i + 4;
+										else if (bMaxDivRange32)
+											divR0 = i + 17;
+											else if (bSpread)
+												divR0 = 8 * i + 8;
+												else divR0 = i + 33;
+						int div = divR0 + r;
+						if (div > maxDiv)
+							div = div % maxDiv; // Applying "modulo" if necessary!
+						rows[nRow][i] = (int8_t)div;
+					}
+				}
+				nRow++;
+			}
+		}
+		// Extra tables don't depend on jumpers/switches: all combinations are sharing same rows.
+		for (int ts = 1; ts < RKD_NUM_TABLESETS; ts++) {
+			int nRotations = ((ts == 1) || (ts == 3)) ? 11 : 8;
+			for (int jc = 0; jc < RKD_NUM_JUMPERS_COMBOS; jc++) {
+				rowFirst[ts][jc] = nRow;
+				rowCount[ts][jc] = nRotations;
+			}
+			for (int r = 0; r < nRotations; r++) {
+				for (int i = 0; i < 8; i++) {
+					switch (ts) {
+						case 1:
+							// Prime numbers: 11 possible "sliding windows" to get access to 8 (consecutive) prime numbers.
+							rows[nRow][i] = (int8_t)tblPrimes[i + r];
+							break;
+						case 2:
+							// Perfect squares: "cell moves" (from bottom to top).
+							rows[nRow][i] = (int8_t)tblSquares[(i + r) % 8];
+							break;
+						case 3:
+							// Fibonacci sequence: 1 possible rotation (first), then 10 possible translations (+R on all ports).
+							if (r < 2)
+								rows[nRow][i] = (int8_t)tblFibonacci[i + r];
+								else rows[nRow][i] = (int8_t)(tblFibonacci[i + 1] + r - 1);
+							break;
+						case 4:
+							// Triplet & 16ths: "cell moves" (from bottom to top).
+							rows[nRow][i] = (int8_t)tblTripletSixteenths[(i + r) % 8];
+							break;
+						case 5:
+							// Multipliers (x4, x3, x2) and dividers: "cell moves" (from bottom to top).
+							rows[nRow][i] = (int8_t)tblMultipliers[(i + r) % 8];
+					}
+				}
+				nRow++;
+			}
+		}
+	}
+
+	// Returns "Max Div" amount for manufacturer table, regardling "Max-Div-Range 16", "Max-Div-Range 32" and "Spread" jumpers/switches setting.
+	static int getManufacturerMaxDiv(bool bMaxDivRange16, bool bMaxDivRange32, bool bSpread) {
+		if (bMaxDivRange16 && bMaxDivRange32 && bSpread)
+			return 16; // Max-Div-Range 16 = On, Max-Div-Range 32 = On: Max Div = 8, but Spread On --> Max Div 16.
+			else if (bMaxDivRange16 && bMaxDivRange32 && !bSpread)
+				return 8; // Max-Div-Range 16 = On, Max-Div-Range 32 = On, Spread Off: Max Div = 8 (it's the default factory).
+				else if (bMaxDivRange16 && !bMaxDivRange32)
+					return 16; // Max-Div-Range 16 = On, Max-Div-Range 32 = Off: Max Div = 16.
+					else if (!bMaxDivRange16 && bMaxDivRange32)
+						return 32; // Max-Div-Range 16 = Off, Max-Div-Range 32 = On: Max Div = 32.
+						else return 64; // Last possible remaining case is... Max-Div-Range 16 = Off, Max-Div-Range 32 = Off: Max Div = 64.
+	}
+
+};
+
+// Built once, shared by all RKD modules (defined in RKD.cpp).
+extern const RKDRotationTables rkdRotationTables;
+
+// Dividers engine lanes: eight RKD output jacks, and eight RKX (expander) output jacks.
+#define RKD_NUM_LANES 16
+
+// ROTATE quantiser hysteresis (ratio of one rotation step): a new rotation is planned only when ROTATE CV moves beyond this margin.
+#define RKD_ROTATE_HYSTERESIS 0.2f
+
+// Humanise: length of random sequence (per output jack), and default seed of this sequence.
+#define RKD_HUMANISE_STEPS 16
+#define RKD_HUMANISE_DEFAULT_SEED 0x2545F491
+
+// Probability: default seed of random sequence.
+#define RKD_PROBABILITY_DEFAULT_SEED 0x6C078965
+
+// Auto-Reset cycle lengths (in CLK pulses), 0 means "2 x Max Div" (factory). Selected via context-menu, or CYCLE CV (RKX
+// expander, 1V per entry).
+#define RKD_NUM_AUTORESET_CYCLES 10
+static const int rkdAutoResetCycles[RKD_NUM_AUTORESET_CYCLES] = {0, 16, 24, 32, 48, 64, 96, 128, 192, 256};
+
+// Clamps value "x" between "a" and "b" (same as Rack SDK clamp).
+static inline float rkdClamp(float x, float a, float b) {
+	return std::fmax(std::fmin(x, b), a);
+}
+
+// Rescales value "x" from range [xMin, xMax] to range [yMin, yMax] (same as Rack SDK rescale).
+static inline float rkdRescale(float x, float xMin, float xMax, float yMin, float yMax) {
+	return yMin + (x - xMin) / (xMax - xMin) * (yMax - yMin);
+}
+
+// Schmitt trigger (same behavior as Rack SDK RKDSchmittTrigger): returns true on low-to-high transition (input reaching 1.0),
+// rearmed when input goes down to 0.0. High state at start (or after reset), so an input already high doesn't trigger.
+struct RKDSchmittTrigger {
+	bool state = true;
+
+	void reset() {
+		state = true;
+	}
+
+	bool process(float in) {
+		if (state) {
+			if (in <= 0.0f)
+				state = false;
+		}
+		else if (in >= 1.0f) {
+			state = true;
+			return true;
+		}
+		return false;
+	}
+};
+
+// Four lanes (signed 32-bit integers) vector, used by dividers engine (same operators as Rack SDK RKDInt4). Comparisons
+// are returning a mask (all bits set on lanes where comparison is true).
+struct RKDInt4 {
+	__m128i v;
+
+	RKDInt4() {}
+	RKDInt4(__m128i v) : v(v) {}
+	RKDInt4(int32_t x) : v(_mm_set1_epi32(x)) {}
+
+	static RKDInt4 load(const int32_t *x) {
+		return RKDInt4(_mm_loadu_si128((const __m128i *)x));
+	}
+
+	// All bits set, on all lanes.
+	static RKDInt4 mask() {
+		return RKDInt4(_mm_set1_epi32(-1));
+	}
+
+	void store(int32_t *x) const {
+		_mm_storeu_si128((__m128i *)x, v);
+	}
+};
+
+static inline RKDInt4 operator+(const RKDInt4 &a, const RKDInt4 &b) {
+	return RKDInt4(_mm_add_epi32(a.v, b.v));
+}
+
+static inline RKDInt4 operator-(const RKDInt4 &a, const RKDInt4 &b) {
+	return RKDInt4(_mm_sub_epi32(a.v, b.v));
+}
+
+static inline RKDInt4 operator&(const RKDInt4 &a, const RKDInt4 &b) {
+	return RKDInt4(_mm_and_si128(a.v, b.v));
+}
+
+static inline RKDInt4 operator|(const RKDInt4 &a, const RKDInt4 &b) {
+	return RKDInt4(_mm_or_si128(a.v, b.v));
+}
+
+static inline RKDInt4 operator~(const RKDInt4 &a) {
+	return RKDInt4(_mm_xor_si128(a.v, _mm_set1_epi32(-1)));
+}
+
+static inline RKDInt4 operator==(const RKDInt4 &a, const RKDInt4 &b) {
+	return RKDInt4(_mm_cmpeq_epi32(a.v, b.v));
+}
+
+static inline RKDInt4 operator>=(const RKDInt4 &a, const RKDInt4 &b) {
+	return ~RKDInt4(_mm_cmplt_epi32(a.v, b.v));
+}
+
+// Bit i set when lane i of the mask is set (sign bit of each lane).
+static inline int rkdMovemask(const RKDInt4 &a) {
+	return _mm_movemask_ps(_mm_castsi128_ps(a.v));
+}
+
+// Xorshift (32-bit) pseudo-random generator: deterministic for a given seed (state must be non-zero).
+static inline uint32_t rkdXorshift32(uint32_t &state) {
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+// Polyphony: each channel (upto 16, given by CLK input cable) has its own clock/rotate/reset states, dividers tables and counters.
+struct RKDChannel {
+	// Schmitt trigger, for RESET input port.
+	RKDSchmittTrigger RESET_Port;
+	// Schmitt trigger, for CLK input port.
+	RKDSchmittTrigger CLK_Port;
+	// This flag, when true, indicates the CLK rising edge at the current step.
+	bool bIsRisingEdge = false;
+	// Next incoming rising edge will be the first rising edge. Required to handle gate modes together with counting up or down.
+	bool bIsEarlyRisingEdge = true;
+	// This flag, when true, indicates the CLK falling edge at the current step.
+	bool bIsFallingEdge = false;
+	// This flag, when true, indicates the CLK is high (voltage equal or higher +2V).
+	bool bCLKisHigh = false;
+	// Assumed timeout at start.
+	bool bCLKTimeOut = true;
+	// Current (active) dividers table.
+	// Lanes 8 to 15 are used by RKX expander (RKD dividers, multiplied by RKX factor).
+	alignas(16) int32_t tblActiveDividers[RKD_NUM_LANES] = {1, 2, 3, 4, 5, 6, 7, 8, 2, 4, 6, 8, 10, 12, 14, 16};
+	// Rotation dividers table (as prepared table).
+	// Future dividers table, when rotation is required (negative values are multipliers).
+	int tblDividersRt[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+	// Multipliers (0: lane is a divider), per lane. Dividers engine is using /1 for multiplier lanes, but their pulses are ignored:
+	// pulses are scheduled from tracked CLK period instead (sub-pulses between two CLK rising edges).
+	int tblMultipliers[RKD_NUM_LANES] = {};
+	// Multiplier lanes (bit i set: lane i), from active table.
+	uint32_t multJacks = 0;
+	// Multiplier lanes: interval between sub-pulses, countdowns (in samples) to next sub-pulse and to its end, remaining sub-pulses
+	// until next CLK rising edge, and lanes having pending sub-pulses (bit i set: lane i).
+	int multInterval[RKD_NUM_LANES] = {};
+	int multCountdown[RKD_NUM_LANES] = {};
+	int multFallCountdown[RKD_NUM_LANES] = {};
+	int multRemaining[RKD_NUM_LANES] = {};
+	uint32_t multPending = 0;
+	// When set (armed), prepare the rotation (set new dividers table).
+	bool bDoRotation = false;
+	// When set (armed), doing rotation on next rising-edge (coming on CLK input port).
+	bool bDoRotationOnRisingEdge = false;
+	// Maximum divide amount (for active table), used by Auto-Reset.
+	int maxDivAmount = 8;
+	// ROTATE (CV) voltage.
+	float cvRotate = 0.0f;
+	// Quantised ROTATE CV (rotation index, with hysteresis), and rotation index (including possible offset given by BRK).
+	int cvRotateQuantized = 0;
+	int cvRotateTblIndex = 0;
+	int cvRotateTblIndexPrevious = 0;
+	// RESET (trigger input port).
+	bool bResetOnJack = false;
+	bool bRegisteredResetOnJack = false;
+	// Step-based (sample) counters.
+	long long int currentStep = 0;
+	// Step of last CLK rising edge (0: none since timeout), and step from which channel is in timeout (0: no timeout yet).
+	long long int lastRisingEdgeStep = 0;
+	long long int timeoutStep = 0;
+	// Smoothed (tracked) period of source CLK, in samples (valid while source frequency is known).
+	float clkPeriod = 0.0f;
+	// Source (CLK) frequency flag (set when source frequency is known).
+	bool bCLKFreqKnown = false;
+	// Dividers counters (one per output jack, including RKX expander), aligned to be loaded as SIMD integer vectors.
+	alignas(16) int32_t divCounters[RKD_NUM_LANES] = {};
+	// Global Auto-Reset sequence counter.
+	int divCountersAutoReset = 0;
+	// Auto-Reset cycle length (in CLK pulses), and lanes to reset at end of each cycle (dividers which don't divide cycle length),
+	// precomputed when table (rotation) or cycle have changed. Cycle setting used to compute them (change detection).
+	int autoResetLength = 16;
+	alignas(16) int32_t autoResetMask[RKD_NUM_LANES] = {};
+	bool bAutoResetAnyLane = false;
+	int autoResetCycleUsed = -1;
+	// Number of completed Auto-Reset sequences (RKX lanes are auto-reset every "factor" sequences).
+	int autoResetSequences = 0;
+	// This flag is set on "Auto-Reset" event.
+	bool bIsAutoReset = false;
+	// This flag allow/inhibit Auto-Reset - temporary (Auto-Reset will not fired after a timeout/reset, or a reset done via RESET jack).
+	bool bAllowAutoReset = false;
+	// This flag is used only for blue RESET (Auto-Reset) LED (too avoid too long flashing LED).
+	bool bAutoResetLEDfired = false;
+	// Output jack is fired (pulsing) when its lane is -1 (all bits set), or 0 if not (SIMD mask).
+	alignas(16) int32_t jackIsFired[RKD_NUM_LANES] = {};
+	// Voltage state of output jacks (bit i set: jack i is high), including RKX expander jacks (bits 8 to 15).
+	uint32_t outputStates = 0;
+	// Output jacks pulsed (state written), and fired (set to high state), during last processed sample.
+	uint32_t changedJacks = 0;
+	uint32_t firedJacks = 0;
+	// Groove: offsets (in samples) precomputed for current period and table, per RKD output jack: swing (delay on even pulses),
+	// and humanise sequence. Period and groove generation used to compute them (change detection).
+	int swingOffset[8] = {};
+	int humaniseOffsets[8][RKD_HUMANISE_STEPS] = {};
+	int grooveClkPeriod = 0;
+	uint32_t grooveGeneration = 0;
+	// Groove: pulse number (since reset, even pulses are swung), and offset of current pulse, per RKD output jack.
+	int groovePulses[8] = {};
+	int grooveOffset[8] = {};
+	// Groove: delayed state changes per RKD output jack, as step numbers ([0]: falling, [1]: rising, 0 if none), and pending jacks.
+	long long int grooveSteps[8][2] = {};
+	uint32_t groovePending = 0;
+	// Probability: random generator state (restarted from seed on timeout, for reproducible renders).
+	uint32_t probabilityState = RKD_PROBABILITY_DEFAULT_SEED;
+};
+
+struct RKDEngine {
+	// Jumpers/switches setting (Counting Up/Dn, Trig./Gate, Auto-Reset).
+	bool bCountingDown = false;
+	bool bGate = false;
+	bool bAutoReset = false;
+	// Table set (0: Manufacturer, 1: Prime numbers, 2: Perfect squares, 3: Fibonacci sequence, 4: Triplet & 16ths, 5: Multipliers, from 8: user tables).
+	int tableSet = 0;
+	// First precomputed row (R+0) for current table, and its number of possible rotations.
+	const int8_t (*rotationRows)[8] = rkdRotationTables.rows;
+	int rotationRowCount = 8;
+	// Rotation offset added to ROTATE index (given by BRK expander).
+	int rotateOffset = 0;
+	// RKX expander: dividers factor (RKX dividers are RKD dividers multiplied by this factor).
+	int rkxFactor = 2;
+	// Clock period tracker: tolerance window (ratio of tracked period), and timeout (number of tracked periods without rising edge).
+	float clkTolerance = 0.05f;
+	int clkTimeoutPeriods = 2;
+	// ROTATE CV slew: one-pole lowpass coefficient (1 means no slew).
+	float rotateSlewCoef = 1.0f;
+	// Groove, per RKD output jack: swing (ratio of pulses pair, 0.5 means no swing), and humanise (maximum random delay, as ratio of
+	// divided period), and the seed of humanise random sequence.
+	float swing[8] = {0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f};
+	float humanise[8] = {};
+	uint32_t humaniseSeed = RKD_HUMANISE_DEFAULT_SEED;
+	// Humanise random sequence (values from 0 to 1), per RKD output jack, built from seed.
+	float humaniseUnits[8][RKD_HUMANISE_STEPS];
+	// RKD output jacks having swing and/or humanise (bit i set: jack i), and groove generation (incremented on each groove change).
+	uint32_t grooveJacks = 0;
+	uint32_t grooveGeneration = 0;
+	// Probability, per RKD output jack (1: every pulse is fired), and seed of random sequence.
+	float probability[8] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+	uint32_t probabilitySeed = RKD_PROBABILITY_DEFAULT_SEED;
+	// Probability thresholds (compared to random numbers), and RKD output jacks having probability (bit i set: jack i).
+	uint32_t probabilityThresholds[8] = {};
+	uint32_t probabilityJacks = 0;
+	// Auto-Reset cycle (0: "2 x Max Div").
+	int autoResetCycle = 0;
+	// Channels (polyphony), having their own states.
+	RKDChannel channels[RKD_NUM_CHANNELS];
+
+	RKDEngine() {
+		setHumaniseSeed(RKD_HUMANISE_DEFAULT_SEED);
+		setGroove();
+		setProbability();
+		for (int c = 0; c < RKD_NUM_CHANNELS; c++)
+			timeOut(c);
+	}
+
+	// Groove change (swing or humanise), from context-menu or json: groove offsets will be computed again by all channels.
+	void setGroove() {
+		uint32_t jacks = 0;
+		for (int i = 0; i < RKD_NUM_OUTPUTS; i++)
+			if ((swing[i] > 0.5f) || (humanise[i] > 0.0f))
+				jacks |= (1 << i);
+		grooveJacks = jacks;
+		grooveGeneration++;
+	}
+
+	// Probability change, from context-menu or json.
+	void setProbability() {
+		uint32_t jacks = 0;
+		for (int i = 0; i < RKD_NUM_OUTPUTS; i++) {
+			probabilityThresholds[i] = (uint32_t)((double)(probability[i]) * 4294967295.0);
+			if (probability[i] < 1.0f)
+				jacks |= (1 << i);
+		}
+		probabilityJacks = jacks;
+	}
+
+	// Random generator state for given channel, from probability seed (never 0).
+	uint32_t getProbabilityState(int c) {
+		uint32_t state = probabilitySeed ^ ((uint32_t)(c) * 0x9E3779B9);
+		return ((state != 0) ? state : RKD_PROBABILITY_DEFAULT_SEED);
+	}
+
+	// Building humanise random sequences from given seed.
+	void setHumaniseSeed(uint32_t givenSeed) {
+		humaniseSeed = ((givenSeed != 0) ? givenSeed : RKD_HUMANISE_DEFAULT_SEED);
+		uint32_t state = humaniseSeed;
+		for (int i = 0; i < RKD_NUM_OUTPUTS; i++)
+			for (int k = 0; k < RKD_HUMANISE_STEPS; k++)
+				humaniseUnits[i][k] = (float)(rkdXorshift32(state) >> 8) / 16777216.0f;
+		grooveGeneration++;
+	}
+
+	// "Counting" jumper/switch. Gate mode only: if "Counting" is changed on the fly, invert firing status for each output jack (all channels).
+	void setCountingDown(bool bNewCountingDown) {
+		if (bGate && (bCountingDown != bNewCountingDown))
+			for (int c = 0; c < RKD_NUM_CHANNELS; c++)
+				for (int i = 0; i < RKD_NUM_LANES; i++)
+					channels[c].jackIsFired[i] = ~channels[c].jackIsFired[i];
+		bCountingDown = bNewCountingDown;
+	}
+
+	// Table change: first precomputed row (R+0) and number of possible rotations, "Max Div" amount, table set and RKX factor.
+	// Rotation (to R+0 row) is armed for all channels, it becomes effective on next CLK rising edge.
+	void setTable(const int8_t (*givenRotationRows)[8], int givenRotationRowCount, int givenMaxDivAmount, int givenTableSet, int givenRkxFactor) {
+		rotationRows = givenRotationRows;
+		rotationRowCount = givenRotationRowCount;
+		tableSet = givenTableSet;
+		rkxFactor = givenRkxFactor;
+		for (int c = 0; c < RKD_NUM_CHANNELS; c++) {
+			RKDChannel &ch = channels[c];
+			ch.maxDivAmount = givenMaxDivAmount;
+			for (int i = 0; i < RKD_NUM_OUTPUTS; i++)
+				ch.tblDividersRt[i] = rotationRows[0][i];
+			// Arming table rotation (required after table change).
+			ch.bDoRotation  = true;
+			ch.bDoRotationOnRisingEdge  = false;
+		}
+	}
+
+	// Given channel goes into timeout (idle) mode, eg when CLK input jack is unwired.
+	void timeOut(int c) {
+		channels[c].changedJacks = 0;
+		channels[c].firedJacks = 0;
+		channelTimeOut(c);
+	}
+
+	// Channel in timeout (idle) mode: reset of its states, flags and counters (all output jacks are low).
+	void channelTimeOut(int c) {
+		RKDChannel &ch = channels[c];
+		// Reset Schmitt trigger used by RESET input jack.
+		ch.RESET_Port.reset();
+		// Defining trigger thresholds for RESET input jack (rescale).
+		//ch.RESET_Port.setThresholds(0.2f, 3.5f);
+		ch.bResetOnJack = false;
+		ch.bRegisteredResetOnJack = false;
+		// Reset Schmitt trigger used by CLK input jack.
+		ch.CLK_Port.reset();
+		// Defining thresholds for CLK input jack (rescale).
+		//ch.CLK_Port.setThresholds(0.2f, 3.5f);
+		// CLK is low (not wired = no signal = false).
+		ch.bCLKisHigh = false;
+		// Reset ROTATE indexes.
+		ch.cvRotateQuantized = 0;
+		ch.cvRotateTblIndex = 0;
+		ch.cvRotateTblIndexPrevious = 0;
+		// Table rotation is on Initialize. For now we're using standard "R+0" base table.
+		ch.bDoRotation  = true;
+		ch.bDoRotationOnRisingEdge = false;
+		// Cancel delayed (groove) state changes, and restart swing sequence.
+		for (int i = 0; i < RKD_NUM_OUTPUTS; i++) {
+			ch.grooveSteps[i][0] = 0;
+			ch.grooveSteps[i][1] = 0;
+			ch.groovePulses[i] = 0;
+		}
+		ch.groovePending = 0;
+		ch.grooveClkPeriod = 0;
+		// Cancel multipliers sub-pulses.
+		ch.multPending = 0;
+		// Restart probability random sequence.
+		ch.probabilityState = getProbabilityState(c);
+		//
+		for (int i = 0; i < RKD_NUM_LANES; i++) {
+			ch.divCounters[i] = 0; // Reset all dividers counters to 0 (for all output jacks, including RKX jacks).
+			pulseOutputJack(c, i, false); // Be sure this jack isn't pulsing.
+		}
+		// Reset "Auto-Reset" counter and related flags.
+		ch.divCountersAutoReset = 0;
+		ch.autoResetSequences = 0;
+		ch.bIsAutoReset = false;
+		ch.bAllowAutoReset = false;
+		ch.bAutoResetLEDfired = false;
+		// Source (CLK) frequency is reset (because CLK signal is lost/absent).
+		ch.bCLKFreqKnown = false;
+		// Reset step-based counters.
+		ch.currentStep = 0;
+		ch.lastRisingEdgeStep = 0;
+		ch.timeoutStep = 0;
+		ch.clkPeriod = 0.0f;
+		// Early rising edge flag. When set, this meaning the next rising edge will be considered as early (first) rising edge. Required for gate modes!
+		ch.bIsEarlyRisingEdge = true;
+		// Set time out flag (this will lit RESET red LED).
+		ch.bCLKTimeOut = true;
+	}
+
+	// Pulse manager. Jacks from 8 are RKX expander jacks.
+	void pulseOutputJack(int c, int givenOutputJack, bool bJackPulseState) {
+		channels[c].jackIsFired[givenOutputJack] = (bJackPulseState ? -1 : 0);
+		writeOutputJacks(c, 1 << givenOutputJack, (bJackPulseState ? 1 << givenOutputJack : 0));
+	}
+
+	// Clock period tracker (on CLK rising edge). Period is smoothed while each new period is into tolerance window, otherwise the
+	// tracker is immediately locked on new period (source frequency changed). Timeout occurs after "timeout" periods without edge.
+	void trackClockPeriod(RKDChannel &ch) {
+		if (ch.lastRisingEdgeStep != 0) {
+			float period = (float)(ch.currentStep - ch.lastRisingEdgeStep);
+			if (ch.bCLKFreqKnown && (std::fabs(period - ch.clkPeriod) <= (ch.clkPeriod * clkTolerance))) {
+				// Source CLK frequency is stable (into tolerance window): smoothing period.
+				ch.clkPeriod += 0.25f * (period - ch.clkPeriod);
+			}
+			else {
+				// Source CLK frequency is established on this (second) rising edge, or was changed.
+				ch.clkPeriod = period;
+				ch.bCLKFreqKnown = true;
+			}
+			ch.timeoutStep = ch.currentStep + (long long int)(ch.clkPeriod * (1.0f + clkTolerance) * clkTimeoutPeriods) + 1;
+		}
+		// This current step (on rising edge) becomes... last rising edge, for next period measure!
+		ch.lastRisingEdgeStep = ch.currentStep;
+	}
+
+	// Clock, rotation, reset and dividers processing, for a given channel (one sample): CLK, ROTATE and RESET voltages in, output
+	// jacks states out (bit i set: jack i is high, including RKX expander jacks from bit 8). Pulsed (and fired) jacks during this
+	// sample are given by "changedJacks" (and "firedJacks") of the channel.
+	uint32_t process(int c, float clkVoltage, float rotateVoltage, float resetVoltage) {
+		RKDChannel &ch = channels[c];
+		ch.changedJacks = 0;
+		ch.firedJacks = 0;
+
+		// CV ROTATE analysis.
+		// CV ROTATE voltage must be between 0V to +5V (inclusive) - otherwise, voltage is clipped (0V is assumed while ROTATE input port isn't wired).
+		float cvRotate = rkdClamp(rotateVoltage, 0.0f, 5.0f);
+		// Optional slew.
+		ch.cvRotate += rotateSlewCoef * (cvRotate - ch.cvRotate);
+
+		// "cvRotateQuantized" is a kind of index to dividers table.
+		// Manufacturer table is based on "Max-Div" amount (jumpers J3-J4, or Max Div switches setting on BRK panel), Primes and Fibonacci on 11 possible rotations,
+		// "Perfect squares" and "Triplet & 16ths" on 8 possible values (one per output jack).
+		// Quantiser with hysteresis: a noisy CV sitting on a boundary doesn't change the index (no more continuous rotations).
+		float rotatePosition = ch.cvRotate * (float)(rotationRowCount) / 5.0f;
+		if (ch.cvRotateQuantized >= rotationRowCount)
+			ch.cvRotateQuantized = rotationRowCount - 1; // Table was changed (less possible rotations).
+		if ((rotatePosition < (float)(ch.cvRotateQuantized) - RKD_ROTATE_HYSTERESIS) || (rotatePosition >= (float)(ch.cvRotateQuantized + 1) + RKD_ROTATE_HYSTERESIS)) {
+			ch.cvRotateQuantized = int(rotatePosition);
+			if (ch.cvRotateQuantized >= rotationRowCount)
+				ch.cvRotateQuantized = rotationRowCount - 1;
+		}
+		ch.cvRotateTblIndex = ch.cvRotateQuantized;
+		// Rotation offset (given by BRK expander).
+		if (rotateOffset != 0)
+			ch.cvRotateTblIndex = (ch.cvRotateTblIndex + rotateOffset) % rotationRowCount;
+
+		// If table index have changed (or rotation was previously set), rotation is required.
+		ch.bDoRotation = ch.bDoRotation || (ch.cvRotateTblIndexPrevious != ch.cvRotateTblIndex);
+
+		// Is table rotation required?
+		if (ch.bDoRotation) {
+			// Clear "preparation" flag.
+			ch.bDoRotation  = false;
+			// Table rotation is required. Set (arm) another/next flag, by this way, real rotation will occur on next CLK rising-edge.
+			ch.bDoRotationOnRisingEdge  = true;
+			// Rotated dividers are precomputed: just copying relevant row.
+			const int8_t *rotationRow = rotationRows[ch.cvRotateTblIndex];
+			for (int i = 0; i < RKD_NUM_OUTPUTS; i++)
+				ch.tblDividersRt[i] = rotationRow[i];
+		}
+
+		// By default assuming this step isn't a CLK rising edge.
+		ch.bIsRisingEdge = false;
+		// By default assuming this step isn't a CLK falling edge.
+		ch.bIsFallingEdge = false;
+
+		// Increment step number.
+		ch.currentStep++;
+		// Using Schmitt trigger (SchmittTrigger is provided by dsp/digital.hpp) to detect triggers on CLK input jack.
+		if (ch.CLK_Port.process(rkdRescale(clkVoltage, 0.2f, 3.5f, 0.0f, 1.0f))) {
+			// It's a rising edge.
+			ch.bIsRisingEdge = true;
+			// Disarm timeout flag.
+			ch.bCLKTimeOut = false;
+			// CLK input is receiving a compliant trigger voltage (trigger on rising edge).
+			// If rotation was requested, it becomes effective on received rising edge. Set the new current dividers table.
+			bool bRotated = ch.bDoRotationOnRisingEdge;
+			if (ch.bDoRotationOnRisingEdge) {
+				ch.multJacks = 0;
+				for (int i = 0; i < RKD_NUM_OUTPUTS; i++) {
+					if (ch.tblDividersRt[i] > 0) {
+						ch.tblActiveDividers[i] = ch.tblDividersRt[i];
+						ch.tblActiveDividers[RKD_NUM_OUTPUTS + i] = ch.tblDividersRt[i] * rkxFactor; // RKX expander lane.
+						ch.tblMultipliers[i] = 0;
+						ch.tblMultipliers[RKD_NUM_OUTPUTS + i] = 0;
+					}
+					else {
+						// Multiplier: RKX expander lane is multiplier divided by RKX factor, rounded (half up) to nearest valid multiplier
+						// or divider, eg with factor 2: x4 becomes x2, x3 (x1.5) becomes x2, and with factor 4: x2 becomes /2, x3 (x0.75)
+						// becomes /1.
+						int multiplier = -ch.tblDividersRt[i];
+						int rkxMultiplier = 0;
+						int rkxDivider = 1;
+						if (multiplier >= rkxFactor)
+							rkxMultiplier = (2 * multiplier + rkxFactor) / (2 * rkxFactor);
+							else rkxDivider = (2 * rkxFactor + multiplier) / (2 * multiplier);
+						ch.tblActiveDividers[i] = 1;
+						ch.tblActiveDividers[RKD_NUM_OUTPUTS + i] = rkxDivider;
+						ch.tblMultipliers[i] = multiplier;
+						ch.tblMultipliers[RKD_NUM_OUTPUTS + i] = ((rkxMultiplier > 1) ? rkxMultiplier : 0);
+					}
+					if (ch.tblMultipliers[i] != 0)
+						ch.multJacks |= (1 << i);
+					if (ch.tblMultipliers[RKD_NUM_OUTPUTS + i] != 0)
+						ch.multJacks |= (1 << (RKD_NUM_OUTPUTS + i));
+				}
+				// Lanes which are no longer multipliers: their pending sub-pulses are cancelled.
+				cancelMultipliers(c, ~ch.multJacks);
+				// Define adaptative "Max Div" amount, but only for "Primes numbers" table!
+				// "Max Div" can be 32 or 64, depending highest divider.
+				if (tableSet == 1) {
+					if (ch.tblActiveDividers[7] > 32)
+						ch.maxDivAmount = 64;
+						else ch.maxDivAmount = 32;
+				}
+				// Rotation was done.
+				ch.bDoRotationOnRisingEdge  = false;
+			}
+			// Tracking period of source CLK.
+			trackClockPeriod(ch);
+			// Groove offsets are computed again only when table (rotation), period or groove setting have changed.
+			// Auto-Reset masks are computed again only when table (rotation) or cycle have changed.
+			if (bRotated || (ch.autoResetCycleUsed != autoResetCycle))
+				computeAutoResetMasks(ch);
+			if ((grooveJacks != 0) && (bRotated || ((int)ch.clkPeriod != ch.grooveClkPeriod) || (ch.grooveGeneration != grooveGeneration)))
+				computeGrooveOffsets(ch);
+			// Of course, on rising edgen the CLK signal is high!
+			ch.bCLKisHigh = true;
+		}
+		else {
+			// At this point it's not a rising edge (maybe incoming signal is already at high state, or low, or a falling edge).
+			// Is it a falling edge?
+			if (ch.bCLKisHigh && (rkdClamp(clkVoltage, 0.0f, 15.0f) < 0.2f)) {
+				// At previous step it was high, but now is low, meaning this step is a falling edge.
+				ch.bCLKisHigh = false; // Below 2V, disarm the flag to stop counting.
+				// It's a falling edge.
+				ch.bIsFallingEdge = true;
+			}
+			// Also, be sure the CLK signal isn't lost: no rising edge since "timeout" periods (kind of "timeout").
+			if ((ch.timeoutStep != 0) && (ch.currentStep >= ch.timeoutStep))
+				channelTimeOut(c); // Timeout: channel becomes "idle".
+		}
+
+		// Using Schmitt trigger (SchmittTrigger is provided by dsp/digital.hpp) to register incoming trigger signal on RESET jack (anytime).
+		if (!ch.bRegisteredResetOnJack)
+			ch.bRegisteredResetOnJack = ch.RESET_Port.process(rkdRescale(resetVoltage, 0.2f, 3.5f, 0.0f, 1.0f));
+
+		// Registered RESET on jack becomes effective on next incoming rising edge.
+		if (ch.bIsRisingEdge) {
+			// Clearing "Auto-Reset" flag.
+			ch.bIsAutoReset = false;
+			// Is RESET jack was triggered?
+			ch.bResetOnJack = ch.bRegisteredResetOnJack;
+			ch.bRegisteredResetOnJack = false;
+			// Global dividers counters reset for all output jacks, due to received pulse on "RESET" jack.
+			if (ch.bResetOnJack) {
+				// Reset Schmitt trigger used by RESET input jack.
+				ch.RESET_Port.reset();
+				// Reset dividers counters (including RKX lanes).
+				for (int i = 0; i < RKD_NUM_LANES; i++)
+					ch.divCounters[i] = 0;
+				// Restart swing sequence.
+				for (int i = 0; i < RKD_NUM_OUTPUTS; i++)
+					ch.groovePulses[i] = 0;
+				// Temporary inhibit Auto-Reset.
+				ch.bAllowAutoReset = false;
+				// Restart Auto-Reset sequence (counter).
+				ch.divCountersAutoReset = 0;
+				ch.autoResetSequences = 0;
+			}		
+		}
+		else ch.bResetOnJack = false;
+
+		// Determine initial pulsing state, only on early rising edge!
+		if (ch.bIsEarlyRisingEdge)
+			for (int i = 0; i < RKD_NUM_LANES; i++)
+				ch.jackIsFired[i] = (bCountingDown ? 0 : -1);
+
+		// Auto-reset and pulsing management (for all output jacks at once).
+		if (ch.bIsRisingEdge) {
+			// On rising edge.
+			// "Auto-Reset" may occurs only if "Auto-Reset" jumper/switch is On, not temporary disabled, and Auto-Reset counter is 0, and for certain dividers.
+			// Lanes to reset are precomputed masks (dividers which don't divide cycle length), then applied by dividers engine.
+			bool bAutoResetStep = (bAutoReset) && (ch.bAllowAutoReset) && (ch.divCountersAutoReset == 0) && (ch.bAutoResetAnyLane);
+			alignas(16) int32_t autoResetLanes[RKD_NUM_LANES] = {};
+			if (bAutoResetStep) {
+				// RKX lanes (divider multiplied by factor) are using a "factor" times longer sequence.
+				int nLanes = ((ch.autoResetSequences % rkxFactor) == 0) ? RKD_NUM_LANES : RKD_NUM_OUTPUTS;
+				for (int i = 0; i < nLanes; i++)
+					autoResetLanes[i] = ch.autoResetMask[i];
+				ch.bIsAutoReset = true;
+				ch.bAutoResetLEDfired = true;
+			}
+			processDividersOnRisingEdge(c, autoResetLanes);
+		}
+		else if (ch.bIsFallingEdge) {
+			// On falling edge (only).
+			processDividersOnFallingEdge(c);
+		}
+
+		// Multipliers: first pulse on CLK rising edge, then sub-pulses (scheduled with sample counters) until next rising edge.
+		if (ch.bIsRisingEdge) {
+			if (ch.multJacks != 0)
+				startMultipliers(c);
+		}
+		else if (ch.multPending != 0)
+			processMultipliers(c);
+
+		// Advance "Auto-Reset" counter (global, on rising edges only).
+		if (ch.bIsRisingEdge) {
+			// Increment "Auto-Reset" sequence counter...
+			ch.divCountersAutoReset++;
+			// ...and restart to 0 when cycle length ("2 x Max-Div" by default) is reached.
+			if (ch.divCountersAutoReset >= ch.autoResetLength) {
+				ch.divCountersAutoReset = 0;
+				ch.autoResetSequences++;
+			}
+			// Now next rising edge aren't first rising edge.
+			ch.bIsEarlyRisingEdge = false;
+			// Allow next Auto-Reset events.
+			ch.bAllowAutoReset = true;
+		}
+		else ch.bResetOnJack = false;
+
+		// Delayed (swung/humanised) state changes: only a step compare per output jack.
+		if (ch.groovePending != 0)
+			applyGroove(c);
+
+		// Update current rotation index to become "previous". This will be useful to detect possible "table rotation" on next step.
+		ch.cvRotateTblIndexPrevious = ch.cvRotateTblIndex;
+
+		return ch.outputStates;
+	}
+
+	// Multipliers: on CLK rising edge, all multiplier lanes are pulsed, then their sub-pulses are scheduled from tracked CLK period.
+	// While CLK period isn't known yet (first rising edge), multiplier lanes aren't pulsed.
+	void startMultipliers(int c) {
+		RKDChannel &ch = channels[c];
+		if (!ch.bCLKFreqKnown) {
+			cancelMultipliers(c, ch.multPending);
+			return;
+		}
+		int pulsedJacks = 0;
+		int jacksState = 0;
+		ch.multPending = 0;
+		for (int i = 0; i < RKD_NUM_LANES; i++) {
+			if (ch.multJacks & (1 << i)) {
+				pulsedJacks |= (1 << i);
+				jacksState |= (1 << i);
+				ch.multInterval[i] = std::max(2, (int)std::round(ch.clkPeriod / (float)(ch.tblMultipliers[i])));
+				ch.multCountdown[i] = ch.multInterval[i];
+				ch.multFallCountdown[i] = ch.multInterval[i] / 2;
+				ch.multRemaining[i] = ch.tblMultipliers[i] - 1;
+				ch.multPending |= (1 << i);
+			}
+		}
+		scheduleOutputJacks(c, pulsedJacks, jacksState);
+	}
+
+	// Multipliers: pending sub-pulses (and delayed state changes, if grooved) of given lanes are cancelled, and these lanes are driven
+	// low (eg lane is no longer a multiplier after a rotation).
+	void cancelMultipliers(int c, uint32_t lanes) {
+		RKDChannel &ch = channels[c];
+		lanes &= ch.multPending;
+		if (lanes == 0)
+			return;
+		ch.multPending &= ~lanes;
+		ch.groovePending &= ~lanes;
+		for (int i = 0; i < RKD_NUM_LANES; i++)
+			if (lanes & (1 << i))
+				ch.jackIsFired[i] = 0;
+		writeOutputJacks(c, lanes, 0);
+	}
+
+	// Multipliers: sub-pulses (50% duty cycle), using integer sample countdowns.
+	void processMultipliers(int c) {
+		RKDChannel &ch = channels[c];
+		int pulsedJacks = 0;
+		int jacksState = 0;
+		for (int i = 0; i < RKD_NUM_LANES; i++) {
+			if (ch.multPending & (1 << i)) {
+				// End of (sub-)pulse.
+				if ((ch.multFallCountdown[i] > 0) && (--ch.multFallCountdown[i] == 0))
+					pulsedJacks |= (1 << i);
+				// Next sub-pulse.
+				if ((ch.multRemaining[i] > 0) && (--ch.multCountdown[i] == 0)) {
+					pulsedJacks |= (1 << i);
+					jacksState |= (1 << i);
+					ch.multRemaining[i]--;
+					ch.multCountdown[i] = ch.multInterval[i];
+					ch.multFallCountdown[i] = ch.multInterval[i] / 2;
+				}
+				if ((ch.multRemaining[i] == 0) && (ch.multFallCountdown[i] == 0))
+					ch.multPending &= ~(1 << i);
+			}
+		}
+		if (pulsedJacks != 0)
+			scheduleOutputJacks(c, pulsedJacks, jacksState);
+	}
+
+	// Auto-Reset cycle length and lanes to reset, for active table.
+	void computeAutoResetMasks(RKDChannel &ch) {
+		ch.autoResetCycleUsed = autoResetCycle;
+		ch.autoResetLength = ((autoResetCycle == 0) ? 2 * ch.maxDivAmount : autoResetCycle);
+		ch.bAutoResetAnyLane = false;
+		for (int i = 0; i < RKD_NUM_OUTPUTS; i++) {
+			bool bReset = (ch.autoResetLength % ch.tblActiveDividers[i]) != 0;
+			ch.autoResetMask[i] = (bReset ? -1 : 0);
+			ch.autoResetMask[RKD_NUM_OUTPUTS + i] = ch.autoResetMask[i]; // RKX lane (same divisibility, on "factor" times longer sequence).
+			ch.bAutoResetAnyLane = ch.bAutoResetAnyLane || bReset;
+		}
+	}
+
+	// Groove offsets (in samples), for current period and active table.
+	void computeGrooveOffsets(RKDChannel &ch) {
+		ch.grooveClkPeriod = (int)ch.clkPeriod;
+		ch.grooveGeneration = grooveGeneration;
+		for (int i = 0; i < RKD_NUM_OUTPUTS; i++) {
+			// Divided (or multiplied) period (unknown while source CLK frequency isn't known: no offset).
+			float period = (ch.bCLKFreqKnown ? ch.clkPeriod * (float)(ch.tblActiveDividers[i]) : 0.0f);
+			if (ch.tblMultipliers[i] != 0)
+				period /= (float)(ch.tblMultipliers[i]);
+			ch.swingOffset[i] = (int)(period * (2.0f * swing[i] - 1.0f));
+			for (int k = 0; k < RKD_HUMANISE_STEPS; k++)
+				ch.humaniseOffsets[i][k] = (int)(period * humanise[i] * humaniseUnits[i][k]);
+		}
+	}
+
+	// Applying delayed state changes of given output jack, if scheduled for current step (or immediately, if "bFlush" is set).
+	void applyGrooveJack(int c, int i, bool bFlush) {
+		RKDChannel &ch = channels[c];
+		if ((ch.grooveSteps[i][1] != 0) && (bFlush || (ch.grooveSteps[i][1] == ch.currentStep))) {
+			ch.grooveSteps[i][1] = 0;
+			writeOutputJacks(c, 1 << i, 1 << i);
+		}
+		if ((ch.grooveSteps[i][0] != 0) && (bFlush || (ch.grooveSteps[i][0] == ch.currentStep))) {
+			ch.grooveSteps[i][0] = 0;
+			writeOutputJacks(c, 1 << i, 0);
+		}
+		if ((ch.grooveSteps[i][0] == 0) && (ch.grooveSteps[i][1] == 0))
+			ch.groovePending &= ~(1 << i);
+	}
+
+	void applyGroove(int c) {
+		for (int i = 0; i < RKD_NUM_OUTPUTS; i++)
+			if (channels[c].groovePending & (1 << i))
+				applyGrooveJack(c, i, false);
+	}
+
+	// Dividers engine output: state changes of RKD output jacks having swing and/or humanise are delayed (scheduled), others
+	// (including RKX expander jacks) are written immediately.
+	void scheduleOutputJacks(int c, int pulsedJacks, int jacksState) {
+		RKDChannel &ch = channels[c];
+		// Probability: each pulse (high state) of RKD output jacks having probability is fired, or skipped (jack stays low).
+		// Random numbers are only drawn on pulse events.
+		uint32_t randomJacks = pulsedJacks & jacksState & probabilityJacks;
+		if (randomJacks != 0)
+			for (int i = 0; i < RKD_NUM_OUTPUTS; i++)
+				if ((randomJacks & (1 << i)) && (rkdXorshift32(ch.probabilityState) >= probabilityThresholds[i]))
+					jacksState &= ~(1 << i);
+		// Jacks no longer having groove: delayed state changes are applied first.
+		uint32_t flushedJacks = pulsedJacks & ~grooveJacks & ch.groovePending;
+		uint32_t delayedJacks = pulsedJacks & grooveJacks;
+		if ((flushedJacks | delayedJacks) == 0) {
+			writeOutputJacks(c, pulsedJacks, jacksState);
+			return;
+		}
+		for (int i = 0; i < RKD_NUM_OUTPUTS; i++) {
+			if (flushedJacks & (1 << i))
+				applyGrooveJack(c, i, true);
+			if (delayedJacks & (1 << i)) {
+				bool bHigh = (jacksState & (1 << i)) != 0;
+				// Expected state once delayed state changes are applied: nothing to do if unchanged.
+				bool bExpected = (ch.grooveSteps[i][0] != 0) ? false : ((ch.grooveSteps[i][1] != 0) || (ch.outputStates & (1 << i)));
+				if (bHigh == bExpected) {
+					pulsedJacks &= ~(1 << i);
+					continue;
+				}
+				if (bHigh) {
+					// New pulse: previous pulse (if still delayed) is completed first.
+					applyGrooveJack(c, i, true);
+					int pulse = ch.groovePulses[i];
+					ch.groovePulses[i] = (pulse + 1) % RKD_HUMANISE_STEPS;
+					ch.grooveOffset[i] = ch.humaniseOffsets[i][pulse] + (((pulse % 2) == 1) ? ch.swingOffset[i] : 0);
+				}
+				// Falling state change is using same offset as its pulse (same pulse width).
+				if (ch.grooveOffset[i] > 0) {
+					ch.grooveSteps[i][bHigh ? 1 : 0] = ch.currentStep + ch.grooveOffset[i];
+					ch.groovePending |= (1 << i);
+					pulsedJacks &= ~(1 << i);
+				}
+			}
+		}
+		writeOutputJacks(c, pulsedJacks, jacksState);
+	}
+
+	// Dividers engine. The eight output jacks (and eight RKX expander jacks) are handled as four SIMD integer vectors (four lanes each):
+	// pulse decisions are masks computed in one pass, then output jacks are written in bulk.
+	// Because dividers counters are always lower than their divider, modulo operations are replaced by comparisons:
+	// - trigger, counting up: (counter + 1) % divider == 0 is counter == divider - 1,
+	// - trigger, counting down: counter % divider == 0 is counter == 0,
+	// - gate, even divider: counter % (divider / 2) == 0 is counter == 0 or 2 x counter == divider,
+	// - gate, odd divider (on falling edge): (counter + (divider - 1) / 2) % divider == 0 is 2 x counter == divider + 1 (/1 always).
+
+	// Writing all pulsed output jacks (bit i of "pulsedJacks" set means jack i is pulsed, to state given by bit i of "jacksState"),
+	// into output states of the channel (voltages are written by the module).
+	void writeOutputJacks(int c, int pulsedJacks, int jacksState) {
+		RKDChannel &ch = channels[c];
+		ch.outputStates = (ch.outputStates & ~pulsedJacks) | (jacksState & pulsedJacks);
+		ch.changedJacks |= pulsedJacks;
+		ch.firedJacks |= (jacksState & pulsedJacks);
+	}
+
+	void processDividersOnRisingEdge(int c, const int32_t *autoResetLanes) {
+		RKDChannel &ch = channels[c];
+		int pulsedJacks = 0;
+		int jacksState = 0;
+		for (int v = 0; v < RKD_NUM_LANES / 4; v++) {
+			RKDInt4 counters = RKDInt4::load(&ch.divCounters[4 * v]);
+			RKDInt4 dividers = RKDInt4::load(&ch.tblActiveDividers[4 * v]);
+			RKDInt4 fired = RKDInt4::load(&ch.jackIsFired[4 * v]);
+			RKDInt4 reset = RKDInt4::load(&autoResetLanes[4 * v]);
+			// "Auto-Reset" lanes first.
+			counters = counters & ~reset;
+			// After a rotation, counter may be over its (new) divider: in this case, modulo-based (scalar) pulse generators are used.
+			if (rkdMovemask(counters >= dividers) != 0) {
+				pulseScalarOnRisingEdge(c, 4 * v, counters, dividers, fired, pulsedJacks, jacksState);
+			}
+			else {
+				RKDInt4 pulsed;
+				RKDInt4 state;
+				if (bGate) {
+					// Gate modes: invert state of pulse on each half-period (even dividers) or period (odd dividers).
+					// /1 in (gate modes) must be considered differently, in fact like... trigger mode! (TBC).
+					RKDInt4 isOdd = ((dividers & RKDInt4(1)) == RKDInt4(1));
+					RKDInt4 isOne = (dividers == RKDInt4(1));
+					RKDInt4 atZero = (counters == RKDInt4(0));
+					RKDInt4 atHalf = ((counters + counters) == dividers) & ~isOdd;
+					pulsed = atZero | atHalf | isOne;
+					state = isOne | (~fired & ~isOne);
+				}
+				else {
+					// Trigger modes (default): all jacks are pulsed.
+					pulsed = RKDInt4::mask();
+					if (bCountingDown)
+						state = (counters == RKDInt4(0)); // Counting down mode.
+						else state = (counters == (dividers - RKDInt4(1))); // Counting up mode (default).
+				}
+				fired = (state & pulsed) | (fired & ~pulsed);
+				pulsedJacks |= rkdMovemask(pulsed) << (4 * v);
+				jacksState |= rkdMovemask(state) << (4 * v);
+			}
+			// Advances dividers counters, restarting to 0 when division value (for each jack) is reached (or over).
+			counters = counters + RKDInt4(1);
+			counters = counters & ~(counters >= dividers);
+			counters.store(&ch.divCounters[4 * v]);
+			fired.store(&ch.jackIsFired[4 * v]);
+		}
+		// Multiplier lanes are pulsed by multipliers, not by dividers engine.
+		pulsedJacks &= ~ch.multJacks;
+		scheduleOutputJacks(c, pulsedJacks, jacksState);
+	}
+
+	void processDividersOnFallingEdge(int c) {
+		RKDChannel &ch = channels[c];
+		int pulsedJacks = 0;
+		int jacksState = 0;
+		for (int v = 0; v < RKD_NUM_LANES / 4; v++) {
+			RKDInt4 pulsed;
+			RKDInt4 state;
+			RKDInt4 fired = RKDInt4::load(&ch.jackIsFired[4 * v]);
+			if (bGate) {
+				// Gate mode: invert state of pulse at middle of period, for odd dividers only.
+				RKDInt4 counters = RKDInt4::load(&ch.divCounters[4 * v]);
+				RKDInt4 dividers = RKDInt4::load(&ch.tblActiveDividers[4 * v]);
+				RKDInt4 isOdd = ((dividers & RKDInt4(1)) == RKDInt4(1));
+				RKDInt4 isOne = (dividers == RKDInt4(1));
+				pulsed = isOdd & (isOne | ((counters + counters) == (dividers + RKDInt4(1))));
+				state = ~fired;
+			}
+			else {
+				// Trigger mode: always stop pulsing on falling edge (for any divider).
+				pulsed = RKDInt4::mask();
+				state = RKDInt4(0);
+			}
+			fired = (state & pulsed) | (fired & ~pulsed);
+			fired.store(&ch.jackIsFired[4 * v]);
+			pulsedJacks |= rkdMovemask(pulsed) << (4 * v);
+			jacksState |= rkdMovemask(state) << (4 * v);
+		}
+		// Multiplier lanes are pulsed by multipliers, not by dividers engine.
+		pulsedJacks &= ~ch.multJacks;
+		scheduleOutputJacks(c, pulsedJacks, jacksState);
+	}
+
+	// Modulo-based pulse generators, for four lanes (from "firstJack"), only used on rising edge following a rotation.
+	void pulseScalarOnRisingEdge(int c, int firstJack, RKDInt4 counters, RKDInt4 dividers, RKDInt4 &fired, int &pulsedJacks, int &jacksState) {
+		alignas(16) int32_t counter[4];
+		alignas(16) int32_t divider[4];
+		alignas(16) int32_t jackIsFired[4];
+		counters.store(counter);
+		dividers.store(divider);
+		fired.store(jackIsFired);
+		for (int l = 0; l < 4; l++) {
+			int i = firstJack + l;
+			int newState = -1; // No pulse.
+			if (bGate) {
+				// Gate modes.
+				if ((divider[l] % 2) == 0) {
+					// On all even dividers...
+					if (counter[l] % (divider[l] / 2) == 0)
+						newState = !jackIsFired[l]; // Invert state of pulse.
+				}
+				else {
+					// On all odd dividers...
+					if (divider[l] == 1)
+						newState = 1;
+					else if ((counter[l] % divider[l]) == 0)
+						newState = !jackIsFired[l]; // Invert state of pulse.
+				}
+			}
+			else {
+				// Trigger modes (default).
+				if (bCountingDown)
+					newState = ((counter[l] % divider[l]) == 0); // Counting down mode.
+					else newState = (((counter[l] + 1) % divider[l]) == 0); // Counting up mode (default).
+			}
+			if (newState != -1) {
+				jackIsFired[l] = (newState ? -1 : 0);
+				pulsedJacks |= (1 << i);
+				if (newState)
+					jacksState |= (1 << i);
+			}
+		}
+		fired = RKDInt4::load(jackIsFired);
+	}
+
+};
+
+// Cycle analysis of RKD output jacks (full pattern length, and next global coincidence), for given active dividers (1 for multiplier
+// lanes, since they're restarting on each CLK pulse), dividers counters, and Auto-Reset cycle (length 0: Auto-Reset isn't active).
+// Not real-time safe (may loop upto two Auto-Reset cycles): only called by UI thread (RKD module widget), never by audio thread.
+struct RKDCycleAnalysis {
+	// Full cycle length (in CLK pulses): least common multiple of dividers (0: unknown, eg CLK isn't connected).
+	uint64_t lcm = 0;
+	// Pattern length (in CLK pulses): full cycle, possibly shortened by Auto-Reset.
+	uint64_t length = 0;
+	// CLK pulses before next global coincidence (all dividers restarting together), 1 meaning next CLK pulse (0: never, until a reset).
+	uint64_t nextCoincidence = 0;
+};
+
+static inline uint64_t rkdGcd(uint64_t a, uint64_t b) {
+	while (b != 0) {
+		uint64_t r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+
+static inline RKDCycleAnalysis rkdAnalyseCycle(const int dividers[RKD_NUM_OUTPUTS], const int counters[RKD_NUM_OUTPUTS], int autoResetLength, int autoResetCounter) {
+	RKDCycleAnalysis analysis;
+	for (int i = 0; i < RKD_NUM_OUTPUTS; i++)
+		if (dividers[i] < 1)
+			return analysis; // Unknown dividers.
+	// Full cycle length: dividers are upto 64, so least common multiple of eight dividers can't overflow.
+	analysis.lcm = 1;
+	for (int i = 0; i < RKD_NUM_OUTPUTS; i++)
+		analysis.lcm = analysis.lcm / rkdGcd(analysis.lcm, dividers[i]) * dividers[i];
+	analysis.length = analysis.lcm;
+	// Auto-Reset is shortening pattern only when, at least, one divider doesn't divide its cycle length.
+	bool bAutoResetAnyLane = false;
+	if (autoResetLength > 0)
+		for (int i = 0; i < RKD_NUM_OUTPUTS; i++)
+			bAutoResetAnyLane = bAutoResetAnyLane || ((autoResetLength % dividers[i]) != 0);
+	if (bAutoResetAnyLane) {
+		// Pattern is restarting on each Auto-Reset: stepping CLK pulse by CLK pulse, upto two Auto-Reset cycles.
+		analysis.length = autoResetLength;
+		int counter[RKD_NUM_OUTPUTS];
+		for (int i = 0; i < RKD_NUM_OUTPUTS; i++)
+			counter[i] = counters[i] % dividers[i];
+		int autoResetStep = autoResetCounter;
+		for (int k = 1; k <= 2 * autoResetLength; k++) {
+			bool bCoincidence = true;
+			for (int i = 0; i < RKD_NUM_OUTPUTS; i++) {
+				if ((autoResetStep == 0) && ((autoResetLength % dividers[i]) != 0))
+					counter[i] = 0; // Auto-Reset on this CLK pulse.
+				bCoincidence = bCoincidence && (counter[i] == 0);
+				counter[i] = (counter[i] + 1) % dividers[i];
+			}
+			if (bCoincidence) {
+				analysis.nextCoincidence = k;
+				break;
+			}
+			autoResetStep = (autoResetStep + 1) % autoResetLength;
+		}
+		return analysis;
+	}
+	// Without Auto-Reset: all counters are 0 after "n" CLK pulses when n = -counter (modulo divider), for each divider. Congruences
+	// are merged one by one (Chinese remainder theorem, for moduli not necessarily coprimes). Each divider being upto 64, merging is
+	// done by trying (at most) 64 candidates.
+	uint64_t n = 0;
+	uint64_t modulus = 1;
+	for (int i = 0; i < RKD_NUM_OUTPUTS; i++) {
+		uint64_t divider = dividers[i];
+		uint64_t remainder = (divider - (counters[i] % dividers[i])) % divider;
+		uint64_t g = rkdGcd(modulus, divider);
+		bool bSolved = false;
+		for (uint64_t t = 0; t < divider / g; t++) {
+			if (((n + modulus * t) % divider) == remainder) {
+				n = n + modulus * t;
+				bSolved = true;
+				break;
+			}
+		}
+		if (!bSolved)
+			return analysis; // Dividers are never restarting together (eg after a rotation), until a reset.
+		modulus = modulus / g * divider;
+	}
+	analysis.nextCoincidence = n + 1;
+	return analysis;
+}
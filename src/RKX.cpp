@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+////// RKX is a 4 HP expander, providing eight extra (polyphonic) output jacks to RKD module.    //////
+////// RKX doesn't have its own clock: dividers are processed by RKD (using same edges, same     //////
+////// table, same resets). RKD writes RKX output jacks and LEDs itself, so they're              //////
+////// sample-aligned with RKD output jacks.                                                     //////
+////// CYCLE input jack (CV) selects Auto-Reset cycle length of RKD.                             //////
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Ohmer.hpp"
+
+struct RKX : Module {
+
+	enum ParamIds {
+		NUM_PARAMS
+	};
+	enum InputIds {
+		CYCLE_INPUT,
+		NUM_INPUTS
+	};
+	enum OutputIds {
+		OUTPUT_9,
+		OUTPUT_10,
+		OUTPUT_11,
+		OUTPUT_12,
+		OUTPUT_13,
+		OUTPUT_14,
+		OUTPUT_15,
+		OUTPUT_16,
+		NUM_OUTPUTS
+	};
+	enum LightIds {
+		LED_OUT_9,
+		LED_OUT_10,
+		LED_OUT_11,
+		LED_OUT_12,
+		LED_OUT_13,
+		LED_OUT_14,
+		LED_OUT_15,
+		LED_OUT_16,
+		NUM_LIGHTS
+	};
+
+	// Set while RKX is attached to RKD (its output jacks and LEDs are written by RKD).
+	bool bRKDattached = false;
+
+	RKX() {
+		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
+		// Labels (tooltips).
+		configInput(CYCLE_INPUT, "Auto-Reset cycle (RKD), 1V per cycle length");
+		configOutput(OUTPUT_9, "9th");
+		configOutput(OUTPUT_10, "10th");
+		configOutput(OUTPUT_11, "11th");
+		configOutput(OUTPUT_12, "12th");
+		configOutput(OUTPUT_13, "13th");
+		configOutput(OUTPUT_14, "14th");
+		configOutput(OUTPUT_15, "15th");
+		configOutput(OUTPUT_16, "16th");
+		// RKX doesn't receive messages: CYCLE CV is written into message buffers of RKD module.
+	}
+
+	void process(const ProcessArgs &args) override {
+		// DSP processing...
+		// RKD placed at left-side of RKX has priority (same rule is used by RKD, to know if RKX is its expander).
+		Module *rkdModule = nullptr;
+		if (leftExpander.module && leftExpander.module->model == modelRKD)
+			rkdModule = leftExpander.module; // RKD at left-side of RKX.
+			else if (rightExpander.module && rightExpander.module->model == modelRKD)
+				rkdModule = rightExpander.module; // RKD at right-side of RKX.
+		// Sending CYCLE CV to RKD.
+		if (rkdModule) {
+			bool bRKDatLeft = (rkdModule == leftExpander.module);
+			RKXCycleMessage *cycleMessage = &((RKDExpanderMessage*)(bRKDatLeft ? rkdModule->rightExpander.producerMessage : rkdModule->leftExpander.producerMessage))->rkx;
+			cycleMessage->bCycleCV = inputs[CYCLE_INPUT].isConnected();
+			cycleMessage->cycleCV = inputs[CYCLE_INPUT].getVoltage();
+			// Flip messages.
+			if (bRKDatLeft)
+				rkdModule->rightExpander.messageFlipRequested = true;
+				else rkdModule->leftExpander.messageFlipRequested = true;
+		}
+		// While attached, output jacks and LEDs are written by RKD (during its own "process", same sample as RKD output jacks). Once
+		// detached, output jacks and LEDs are low.
+		if (!rkdModule && bRKDattached) {
+			for (int i = OUTPUT_9; i < NUM_OUTPUTS; i++) {
+				outputs[i].setChannels(1);
+				outputs[i].setVoltage(0.0f);
+				lights[LED_OUT_9 + i].setBrightness(0.0f);
+			}
+		}
+		bRKDattached = (rkdModule != nullptr);
+	} // end of "process"...
+
+}; // End of module (object) definition.
+
+///////////////////////////////////////////////// MODULE WIDGET SECTION /////////////////////////////////////////////////
+
+struct RKXWidget : ModuleWidget {
+	// RKX panels (light, dark).
+	SvgPanel *panelRKXlight;
+	SvgPanel *panelRKXdark;
+
+	RKXWidget(RKX *module) {
+		setModule(module);
+		box.size = Vec(4 * RACK_GRID_WIDTH, RACK_GRID_HEIGHT);
+		// RKX light panel.
+		panelRKXlight = new SvgPanel();
+		panelRKXlight->setBackground(APP->window->loadSvg(asset::plugin(pluginInstance, "res/RKX_light.svg")));
+		panelRKXlight->visible = !rack::settings::preferDarkPanels; // Light panel.
+		addChild(panelRKXlight);
+		// RKX dark panel.
+		panelRKXdark = new SvgPanel();
+		panelRKXdark->setBackground(APP->window->loadSvg(asset::plugin(pluginInstance, "res/RKX_dark.svg")));
+		panelRKXdark->visible = rack::settings::preferDarkPanels; // Dark panel.
+		addChild(panelRKXdark);
+		// Like RKD module, we're using only two screws (top and bottom).
+		// Top screw.
+		addChild(createWidget<Torx_Silver>(Vec(RACK_GRID_WIDTH, 0)));
+		// Bottom screw.
+		addChild(createWidget<Torx_Silver>(Vec(RACK_GRID_WIDTH, RACK_GRID_HEIGHT - RACK_GRID_WIDTH)));
+		// CYCLE input jack (Auto-Reset cycle of RKD).
+		addInput(createInput<CL1362_In>(Vec(16.8, 52), module, RKX::CYCLE_INPUT));
+		// Output jacks (aligned to RKD output jacks).
+		addOutput(createOutput<CL1362_Out>(Vec(30.8, 96), module, RKX::OUTPUT_9));
+		addOutput(createOutput<CL1362_Out>(Vec(30.8, 126), module, RKX::OUTPUT_10));
+		addOutput(createOutput<CL1362_Out>(Vec(30.8, 156), module, RKX::OUTPUT_11));
+		addOutput(createOutput<CL1362_Out>(Vec(30.8, 186), module, RKX::OUTPUT_12));
+		addOutput(createOutput<CL1362_Out>(Vec(30.8, 216), module, RKX::OUTPUT_13));
+		addOutput(createOutput<CL1362_Out>(Vec(30.8, 246), module, RKX::OUTPUT_14));
+		addOutput(createOutput<CL1362_Out>(Vec(30.8, 276), module, RKX::OUTPUT_15));
+		addOutput(createOutput<CL1362_Out>(Vec(30.8, 306), module, RKX::OUTPUT_16));
+		// LEDs (same colors as RKD LEDs, for the same rows).
+		addChild(createLight<MediumLight<RedLight>>(Vec(3.7, 103.4), module, RKX::LED_OUT_9));
+		addChild(createLight<MediumLight<RKDOrangeLight>>(Vec(3.7, 133.4), module, RKX::LED_OUT_10));
+		addChild(createLight<MediumLight<YellowLight>>(Vec(3.7, 163.4), module, RKX::LED_OUT_11));
+		addChild(createLight<MediumLight<GreenLight>>(Vec(3.7, 193.4), module, RKX::LED_OUT_12));
+		addChild(createLight<MediumLight<GreenLight>>(Vec(3.7, 223.4), module, RKX::LED_OUT_13));
+		addChild(createLight<MediumLight<BlueLight>>(Vec(3.7, 253.4), module, RKX::LED_OUT_14));
+		addChild(createLight<MediumLight<RKDPurpleLight>>(Vec(3.7, 283.4), module, RKX::LED_OUT_15));
+		addChild(createLight<MediumLight<RKDWhiteLight>>(Vec(3.7, 313.4), module, RKX::LED_OUT_16));
+	}
+
+	void step() override {
+		// Depending "Use dark panels if available" option (from "View" menu), use the light or dark panel.
+		panelRKXlight->visible = !rack::settings::preferDarkPanels;
+		panelRKXdark->visible = rack::settings::preferDarkPanels;
+		ModuleWidget::step();
+	}
+
+};
+
+Model *modelRKX = createModel<RKX, RKXWidget>("RKX");